@@ -0,0 +1,42 @@
+#include "Benchmarks.h"
+#include "GraphAlgorithms.h"
+#include "ThreadPool.h"
+#include <cstdio>
+
+static double timeApsp(Graph* g, ApspMode mode, ThreadPool* pool) {
+    int size;
+    int* idMap;
+    Stopwatch sw;
+    int** dist = GraphAlgorithms::getAllPairsShortestPaths(g, size, idMap, mode, pool);
+    double t = sw.elapsedMs();
+    GraphAlgorithms::freeMatrix(dist, size);
+    delete[] idMap;
+    return t;
+}
+
+void benchAllPairs() {
+    ThreadPool single(1);
+    ThreadPool& all = ThreadPool::global();
+    std::printf("hilos disponibles: %d\n", all.threadCount());
+
+    struct Case { const char* name; int n; int degree; };
+    const Case cases[] = {
+        {"disperso", 3000, 4},
+        {"denso", 2000, 300},
+    };
+
+    std::printf("grafo      V     E/V  modo          1 hilo ms  %d hilos ms\n", all.threadCount());
+    for (const Case& c : cases) {
+        Graph* g = makeSyntheticGraph(c.n, c.degree, true);
+        const ApspMode modes[] = {ApspMode::FloydWarshall, ApspMode::RepeatedDijkstra};
+        const char* names[] = {"Floyd-Warshall", "Dijkstra x V"};
+        for (int m = 0; m < 2; ++m) {
+            double t1 = timeApsp(g, modes[m], &single);
+            double tn = timeApsp(g, modes[m], &all);
+            std::printf("%-9s %5d %6d  %-13s %10.0f  %10.0f\n", c.name, c.n, c.degree, names[m], t1, tn);
+        }
+        std::printf("%-9s %5d %6d  %-13s %10s  %10.0f\n", c.name, c.n, c.degree, "Auto", "",
+                    timeApsp(g, ApspMode::Auto, &all));
+        delete g;
+    }
+}
@@ -0,0 +1,70 @@
+#include "Benchmarks.h"
+#include "GraphAlgorithms.h"
+#include <cmath>
+#include <cstdio>
+
+// Previous implementation: the full distance matrix, reduced row by row
+static double* closenessFromMatrix(Graph* g, int*& idMap, int& size) {
+    int** d = GraphAlgorithms::getAllPairsShortestPaths(g, size, idMap);
+    double* c = new double[size];
+    for (int i = 0; i < size; ++i) {
+        double sum = 0;
+        int reachable = 0;
+        for (int j = 0; j < size; ++j) {
+            if (i != j && d[i][j] < GraphAlgorithms::INF) {
+                sum += d[i][j];
+                reachable++;
+            }
+        }
+        c[i] = sum > 0 ? reachable / sum : 0;
+    }
+    GraphAlgorithms::freeMatrix(d, size);
+    return c;
+}
+
+static const int kMatrixLimit = 5000;
+
+void benchCloseness() {
+    const int sides[] = {50, 70, 150};
+    const int samples = 256;
+    std::printf("      V  matriz_ms  exacta_ms  muestreada_ms  error_rel_max  cota\n");
+    for (int side : sides) {
+        Graph* g = makeGridGraph(side);
+        int n = side * side;
+        int size;
+        int* idMap;
+
+        double tMatrix = -1;
+        if (n <= kMatrixLimit) {
+            Stopwatch sw;
+            double* c = closenessFromMatrix(g, idMap, size);
+            tMatrix = sw.elapsedMs();
+            delete[] c;
+            delete[] idMap;
+        }
+
+        Stopwatch sw;
+        double* exact = GraphAlgorithms::getClosenessCentrality(g, idMap, size);
+        double tExact = sw.elapsedMs();
+        delete[] idMap;
+
+        double bound;
+        sw.reset();
+        double* approx = GraphAlgorithms::getClosenessCentrality(g, idMap, size, samples, &bound);
+        double tSampled = sw.elapsedMs();
+        delete[] idMap;
+
+        double worst = 0;
+        for (int i = 0; i < size; ++i) {
+            double rel = std::fabs(approx[i] - exact[i]) / exact[i];
+            if (rel > worst) worst = rel;
+        }
+
+        if (tMatrix < 0) std::printf("%7d  %9s", n, "omitido");
+        else std::printf("%7d  %9.0f", n, tMatrix);
+        std::printf("  %9.0f  %13.0f  %13.3f  %.3f\n", tExact, tSampled, worst, bound);
+        delete[] exact;
+        delete[] approx;
+        delete g;
+    }
+}
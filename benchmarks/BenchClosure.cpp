@@ -0,0 +1,67 @@
+#include "Benchmarks.h"
+#include "CompactGraph.h"
+#include "GraphAlgorithms.h"
+#include <cstdio>
+
+// Previous implementation: one bool per pair, row-by-row allocations and a
+// scalar triple loop
+static bool** boolWarshall(const CompactGraph& cg) {
+    int n = cg.vertexCount();
+    bool** reach = new bool*[n];
+    for (int i = 0; i < n; ++i) {
+        reach[i] = new bool[n]();
+        for (int s = cg.edgeBegin(i); s < cg.edgeEnd(i); ++s) reach[i][cg.target(s)] = true;
+    }
+    for (int k = 0; k < n; ++k)
+        for (int i = 0; i < n; ++i)
+            for (int j = 0; j < n; ++j)
+                reach[i][j] = reach[i][j] || (reach[i][k] && reach[k][j]);
+    return reach;
+}
+
+static const int kBoolLimit = 2000;
+
+void benchClosure() {
+    const int sizes[] = {1000, 2000, 4000, 8000};
+    const int degrees[] = {2, 16};
+    std::printf("    N  aristas/v  bool_ms  bitset_ms  condensado_ms\n");
+    for (int epv : degrees) {
+        for (int n : sizes) {
+            Graph* g = makeSyntheticGraph(n, epv, true);
+            CompactGraph cg(g);
+            int size;
+            double tBool = -1;
+            bool same = true;
+
+            Stopwatch sw;
+            BitMatrix* bits = GraphAlgorithms::getPathMatrix(g, size, ClosureMode::Warshall);
+            double tBits = sw.elapsedMs();
+
+            sw.reset();
+            BitMatrix* condensed = GraphAlgorithms::getPathMatrix(g, size, ClosureMode::Condensed);
+            double tCondensed = sw.elapsedMs();
+
+            if (n <= kBoolLimit) {
+                sw.reset();
+                bool** reach = boolWarshall(cg);
+                tBool = sw.elapsedMs();
+                for (int i = 0; i < n; ++i) {
+                    for (int j = 0; j < n; ++j) same = same && reach[i][j] == bits->get(i, j);
+                    delete[] reach[i];
+                }
+                delete[] reach;
+            }
+            for (int i = 0; i < n && same; ++i) {
+                for (int j = 0; j < n; ++j) same = same && condensed->get(i, j) == bits->get(i, j);
+            }
+
+            if (tBool < 0) std::printf("%5d  %9d  %7s", n, epv, "omitido");
+            else std::printf("%5d  %9d  %7.0f", n, epv, tBool);
+            std::printf("  %9.1f  %13.1f%s\n", tBits, tCondensed, same ? "" : "  RESULTADOS DISTINTOS");
+
+            delete bits;
+            delete condensed;
+            delete g;
+        }
+    }
+}
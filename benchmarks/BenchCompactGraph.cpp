@@ -0,0 +1,126 @@
+#include "Benchmarks.h"
+#include "CompactGraph.h"
+#include "GraphAlgorithms.h"
+#include <cstdio>
+#include <iostream>
+
+// Dijkstra as it was written against the pointer structure: O(V) getIndex
+// per relaxed edge plus a Graph lookup per settled vertex. Distances only.
+static int legacyIndex(int id, int* idMap, int size) {
+    for (int i = 0; i < size; ++i) {
+        if (idMap[i] == id) return i;
+    }
+    return -1;
+}
+
+static long long legacyDijkstraReach(Graph* graph, int startId) {
+    int size = graph->getVertices().size();
+    int* idMap = new int[size];
+    int i = 0;
+    for (auto v : graph->getVertices()) idMap[i++] = v->id;
+
+    int* dist = new int[size];
+    bool* visited = new bool[size];
+    for (i = 0; i < size; ++i) { dist[i] = 1e9; visited[i] = false; }
+    dist[legacyIndex(startId, idMap, size)] = 0;
+
+    for (int round = 0; round < size; ++round) {
+        int u = -1;
+        int minVal = 1e9;
+        for (int j = 0; j < size; ++j) {
+            if (!visited[j] && dist[j] < minVal) { minVal = dist[j]; u = j; }
+        }
+        if (u == -1) break;
+        visited[u] = true;
+        for (auto e : graph->getVertex(idMap[u])->edges) {
+            int v = legacyIndex(e->dest->id, idMap, size);
+            if (!visited[v] && dist[u] + e->weight < dist[v]) dist[v] = dist[u] + e->weight;
+        }
+    }
+
+    long long total = 0;
+    for (i = 0; i < size; ++i) if (dist[i] < 1e9) total += dist[i];
+    delete[] idMap;
+    delete[] dist;
+    delete[] visited;
+    return total;
+}
+
+// Full BFS over the pointer structure (visited flags keyed by Vertex*)
+static long long pointerBfs(Graph* graph, Vertex* start) {
+    HashMap<Vertex*, bool> visited;
+    int size = graph->getVertices().size();
+    Vertex** queue = new Vertex*[size];
+    int head = 0, tail = 0;
+    queue[tail++] = start;
+    visited.insert(start, true);
+    long long sum = 0;
+    while (head < tail) {
+        Vertex* u = queue[head++];
+        for (auto e : u->edges) {
+            sum += e->weight;
+            if (visited.insert(e->dest, true)) queue[tail++] = e->dest;
+        }
+    }
+    delete[] queue;
+    return sum;
+}
+
+static long long csrBfs(const CompactGraph& cg, int start) {
+    int size = cg.vertexCount();
+    bool* visited = new bool[size];
+    for (int i = 0; i < size; ++i) visited[i] = false;
+    int* queue = new int[size];
+    const int* offsets = cg.offsetArray();
+    const int* targets = cg.targetArray();
+    const int* weights = cg.weightArray();
+    int head = 0, tail = 0;
+    queue[tail++] = start;
+    visited[start] = true;
+    long long sum = 0;
+    while (head < tail) {
+        int u = queue[head++];
+        for (int s = offsets[u]; s < offsets[u + 1]; ++s) {
+            sum += weights[s];
+            if (!visited[targets[s]]) {
+                visited[targets[s]] = true;
+                queue[tail++] = targets[s];
+            }
+        }
+    }
+    delete[] queue;
+    delete[] visited;
+    return sum;
+}
+
+void benchCompactGraph() {
+    // 250k vertices x 4 = 1M edges
+    Graph* big = makeSyntheticGraph(250000, 4, true);
+
+    Stopwatch sw;
+    CompactGraph* cg = new CompactGraph(big);
+    std::printf("snapshot (V=%d, E=%d): %.1f ms\n", cg->vertexCount(), cg->edgeCount(), sw.elapsedMs());
+
+    sw.reset();
+    long long a = pointerBfs(big, big->getVertex(1));
+    double tPointer = sw.elapsedMs();
+    sw.reset();
+    long long b = csrBfs(*cg, cg->indexOf(1));
+    double tCsr = sw.elapsedMs();
+    std::printf("BFS completo   punteros: %.1f ms   CSR: %.1f ms   (x%.1f)%s\n",
+                tPointer, tCsr, tPointer / tCsr, a == b ? "" : "  RESULTADOS DISTINTOS");
+    delete cg;
+    delete big;
+
+    // The getIndex-based Dijkstra is O(V*E), so it only fits a small graph
+    Graph* small = makeSyntheticGraph(10000, 4, true);
+    small->addVertex(10001, "aislado", 0, 0); // unreachable target: no early exit
+    sw.reset();
+    legacyDijkstraReach(small, 1);
+    double tLegacy = sw.elapsedMs();
+    sw.reset();
+    GraphAlgorithms::getShortestPathDijkstra(small, 1, 10001);
+    double tNew = sw.elapsedMs();
+    std::printf("Dijkstra V=10000   getIndex: %.1f ms   CSR: %.1f ms\n", tLegacy, tNew);
+    delete small;
+}
@@ -0,0 +1,56 @@
+#include "Benchmarks.h"
+#include "CompressedGraphFile.h"
+#include "FileController.h"
+#include "MappedFile.h"
+#include <cstdio>
+#include <fstream>
+
+static double fileMb(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    return in.is_open() ? in.tellg() / (1024.0 * 1024.0) : 0;
+}
+
+// Size of the .graphz file against the text and binary ones, and how fast it
+// decodes. The grid has the local IDs the delta coding is meant for; the
+// random graph's neighbours are spread over the whole ID range.
+void benchCompression() {
+    struct Case { const char* name; Graph* graph; };
+    Case cases[] = {
+        {"rejilla 1000x1000", makeGridGraph(1000)},
+        {"aleatorio 1M x 5", makeSyntheticGraph(1000000, 5, true)},
+    };
+    std::printf("grafo               texto_MB  binario_MB  graphz_MB  vs_texto  vs_binario  decodificar_ms  MB/s  cargar_ms\n");
+    for (Case& c : cases) {
+        std::string textPath = benchTempPath("bench_compression.graph");
+        std::string binaryPath = benchTempPath("bench_compression.graphb");
+        std::string path = benchTempPath("bench_compression.graphz");
+        FileController::saveGraph(c.graph, textPath, GraphFileFormat::Text);
+        FileController::saveGraph(c.graph, binaryPath, GraphFileFormat::Binary);
+        FileController::saveGraph(c.graph, path, GraphFileFormat::Compressed);
+        double text = fileMb(textPath), binary = fileMb(binaryPath), compressed = fileMb(path);
+
+        // Decode only: varints into the flat arrays, no Graph
+        MappedFile mapped;
+        mapped.open(path);
+        CompressedGraphFile file;
+        Stopwatch sw;
+        bool ok = file.decode(mapped.data(), mapped.size());
+        double decode = sw.elapsedMs();
+        file.clear();
+        mapped.close();
+
+        sw.reset();
+        Graph* loaded = FileController::loadGraph(path);
+        double load = sw.elapsedMs();
+        ok = ok && loaded && loaded->getVertices().size() == c.graph->getVertices().size();
+        delete loaded;
+
+        std::printf("%-18s  %8.1f  %10.1f  %9.1f  %7.1fx  %9.1fx  %14.0f  %4.0f  %9.0f%s\n", c.name, text, binary,
+                    compressed, text / compressed, binary / compressed, decode, compressed / (decode / 1000), load,
+                    ok ? "" : "  ERROR");
+        std::remove(textPath.c_str());
+        std::remove(binaryPath.c_str());
+        std::remove(path.c_str());
+        delete c.graph;
+    }
+}
@@ -0,0 +1,47 @@
+#include "Benchmarks.h"
+#include "GraphAlgorithms.h"
+#include <cstdio>
+#include <random>
+
+void benchDijkstra() {
+    // ~500k vertices, ~1M undirected connections
+    const int side = 708;
+    Graph* g = makeGridGraph(side);
+    int n = side * side;
+    std::printf("grid %dx%d (V=%d)\n", side, side, n);
+
+    Stopwatch sw;
+    CompactGraph cg(g, true);
+    std::printf("instantánea CSR (con aristas inversas): %.1f ms\n", sw.elapsedMs());
+
+    const int queries = 20;
+    const char* names[] = {"Dijkstra", "Bidireccional", "A*"};
+    for (int mode = 0; mode < 3; ++mode) {
+        std::mt19937 rng(7); // same queries for every mode
+        std::uniform_int_distribution<int> pick(1, n);
+        double total = 0;
+        double worst = 0;
+        long long settledTotal = 0;
+        for (int q = 0; q < queries; ++q) {
+            int a = pick(rng);
+            int b = pick(rng);
+            int settled = 0;
+            sw.reset();
+            if (mode == 0) GraphAlgorithms::getShortestPathDijkstra(cg, a, b, &settled);
+            else if (mode == 1) GraphAlgorithms::getShortestPathBidirectional(cg, a, b, &settled);
+            else GraphAlgorithms::getShortestPathAStar(cg, a, b, &settled);
+            double t = sw.elapsedMs();
+            total += t;
+            settledTotal += settled;
+            if (t > worst) worst = t;
+        }
+        std::printf("%-14s media %6.1f ms, peor %6.1f ms, nodos asentados (media) %lld\n",
+                    names[mode], total / queries, worst, settledTotal / queries);
+    }
+
+    sw.reset();
+    ShortestPathTree* tree = GraphAlgorithms::getShortestPathTree(cg, 1);
+    std::printf("árbol completo desde una fuente: %.1f ms\n", sw.elapsedMs());
+    delete tree;
+    delete g;
+}
@@ -0,0 +1,56 @@
+#include "Benchmarks.h"
+#include "BinaryGraphFile.h"
+#include "CompactGraph.h"
+#include "FileController.h"
+#include <cstdio>
+#include <fstream>
+
+static double fileMb(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    return in.is_open() ? in.tellg() / (1024.0 * 1024.0) : 0;
+}
+
+// Save and load throughput of each on-disk format for the same graph
+void benchFileFormats() {
+    struct Case { int n; int epv; };
+    const Case cases[] = {{200000, 5}, {1000000, 5}};
+    std::printf("formato     vertices   aristas  archivo_MB  guardar_ms  cargar_ms  cargar_MB/s\n");
+    for (const Case& c : cases) {
+        Graph* g = makeSyntheticGraph(c.n, c.epv, true);
+        CompactGraph cg(g);
+        int edges = cg.edgeCount();
+
+        const GraphFileFormat formats[] = {GraphFileFormat::Text, GraphFileFormat::Binary};
+        const char* names[] = {"texto", "binario"};
+        const char* files[] = {"bench_formats.graph", "bench_formats.graphb"};
+        for (int f = 0; f < 2; ++f) {
+            std::string path = benchTempPath(files[f]);
+            Stopwatch sw;
+            bool saved = FileController::saveGraph(g, path, formats[f]);
+            double tSave = sw.elapsedMs();
+
+            sw.reset();
+            Graph* loaded = FileController::loadGraph(path);
+            double tLoad = sw.elapsedMs();
+            double mb = fileMb(path);
+            bool ok = saved && loaded && loaded->getVertices().size() == (size_t)c.n;
+            std::printf("%-10s  %8d  %8d  %10.1f  %10.0f  %9.0f  %11.0f%s\n", names[f], c.n, edges, mb, tSave,
+                        tLoad, mb / (tLoad / 1000), ok ? "" : "  ERROR");
+            delete loaded;
+
+            if (formats[f] == GraphFileFormat::Binary) {
+                // Mapping plus validation only: what a reader that uses the
+                // arrays in place pays
+                sw.reset();
+                BinaryGraphFile mapped;
+                bool opened = mapped.open(path);
+                long long checksum = 0;
+                for (int s = 0; opened && s < mapped.edgeCount(); ++s) checksum += mapped.weightArray()[s];
+                std::printf("%-10s  %8d  %8d  %10.1f  %10s  %9.1f  %11s  (checksum %lld)\n", "mmap", c.n, edges, mb,
+                            "-", sw.elapsedMs(), "-", checksum);
+            }
+            std::remove(path.c_str());
+        }
+        delete g;
+    }
+}
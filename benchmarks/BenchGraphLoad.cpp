@@ -0,0 +1,91 @@
+#include "Benchmarks.h"
+#include "FileController.h"
+#include <cstdio>
+#include <iostream>
+
+// Reproduces the pre-index Graph: every lookup walks the vertex list.
+// Only used as the "before" column.
+class LinearScanGraph {
+public:
+    ~LinearScanGraph() {
+        for (auto v : vertices) {
+            for (auto e : v->edges) delete e;
+            delete v;
+        }
+    }
+
+    Vertex* addVertex(int id, const std::string& label, int x, int y) {
+        for (auto v : vertices) {
+            if (v->id == id) return nullptr;
+        }
+        Vertex* v = new Vertex(id, label, x, y);
+        vertices.push_back(v);
+        return v;
+    }
+
+    Vertex* getVertex(int id) {
+        for (auto v : vertices) {
+            if (v->id == id) return v;
+        }
+        return nullptr;
+    }
+
+    bool addEdge(int srcId, int destId, int weight) {
+        Vertex* src = getVertex(srcId);
+        Vertex* dest = getVertex(destId);
+        if (!src || !dest) return false;
+        for (auto e : src->edges) {
+            if (e->dest == dest) return false;
+        }
+        src->edges.push_back(new Edge(src, dest, weight));
+        return true;
+    }
+
+private:
+    VertexList vertices;
+};
+
+// The quadratic baseline needs ~2.5 min at 100k vertices, so only the
+// smallest size runs it
+static const int kLinearScanLimit = 10000;
+
+void benchGraphLoad() {
+    const int sizes[] = {10000, 100000, 1000000};
+    const int edgesPerVertex = 2;
+
+    std::cout << "vertices  build_before_ms  build_after_ms  file_load_ms" << std::endl;
+    for (int n : sizes) {
+        int edgeCount;
+        SyntheticEdge* edges = makeSyntheticEdges(n, edgesPerVertex, 42, edgeCount);
+
+        double before = -1;
+        if (n <= kLinearScanLimit) {
+            Stopwatch sw;
+            LinearScanGraph legacy;
+            for (int v = 1; v <= n; ++v) legacy.addVertex(v, "N", 0, 0);
+            for (int i = 0; i < edgeCount; ++i) legacy.addEdge(edges[i].src, edges[i].dst, edges[i].weight);
+            before = sw.elapsedMs();
+        }
+
+        Stopwatch sw;
+        {
+            Graph g(true, true);
+            for (int v = 1; v <= n; ++v) g.addVertex(v, "N", 0, 0);
+            for (int i = 0; i < edgeCount; ++i) g.addEdge(edges[i].src, edges[i].dst, edges[i].weight);
+            double after = sw.elapsedMs();
+
+            std::string path = benchTempPath("bench_load.graph");
+            writeSyntheticGraphFile(path, n, edgesPerVertex, true);
+            sw.reset();
+            Graph* loaded = FileController::loadGraph(path);
+            double load = sw.elapsedMs();
+            delete loaded;
+            std::remove(path.c_str());
+
+            std::printf("%8d  %15s  %14.1f  %12.1f\n", n,
+                        before < 0 ? "omitido" : std::to_string((long long)before).c_str(),
+                        after, load);
+        }
+        delete[] edges;
+    }
+}
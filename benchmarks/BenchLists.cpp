@@ -0,0 +1,60 @@
+#include "Benchmarks.h"
+#include <cstdio>
+#include <random>
+
+// push_back, full iteration, removal from the front and by value on 10^6
+// pointers, the element type Vertex::edges and Graph::vertices hold
+static const int kElements = 1000000;
+static const int kValueRemovals = 200;
+
+template <typename List>
+static void measure(const char* name, List& list, int* values) {
+    Stopwatch sw;
+    for (int i = 0; i < kElements; ++i) list.push_back(&values[i]);
+    double tPush = sw.elapsedMs();
+
+    sw.reset();
+    long long sum = 0;
+    for (int round = 0; round < 10; ++round) {
+        for (int* p : list) sum += *p;
+    }
+    double tIterate = sw.elapsedMs() / 10;
+
+    // By value: a linear search each, from random positions
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> pick(0, kElements - 1);
+    sw.reset();
+    for (int i = 0; i < kValueRemovals; ++i) list.remove(&values[pick(rng)]);
+    double tRemoveValue = sw.elapsedMs();
+
+    sw.reset();
+    while (!list.isEmpty()) list.remove(list.front());
+    double tRemoveFront = sw.elapsedMs();
+
+    std::printf("%-18s  %7.1f  %8.2f  %11.1f  %12.1f%s\n", name, tPush, tIterate, tRemoveValue, tRemoveFront,
+                sum == 10LL * kElements * (kElements - 1) / 2 ? "" : "  SUMA INCORRECTA");
+}
+
+void benchLists() {
+    int* values = new int[kElements];
+    for (int i = 0; i < kElements; ++i) values[i] = i;
+    std::printf("lista               push_ms  iter_ms  remove200_ms  vaciar_ms\n");
+    {
+        LinkedList<int*> list;
+        measure("LinkedList", list, values);
+    }
+    {
+        UnrolledList<int*, 8> list;
+        measure("Unrolled<8>", list, values);
+    }
+    {
+        UnrolledList<int*, 32> list;
+        measure("Unrolled<32>", list, values);
+    }
+    {
+        ObjectPool<UnrolledList<int*, 32>::Chunk> pool;
+        UnrolledList<int*, 32> list(&pool);
+        measure("Unrolled<32>+pool", list, values);
+    }
+    delete[] values;
+}
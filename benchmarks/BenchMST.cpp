@@ -0,0 +1,77 @@
+#include "Benchmarks.h"
+#include "CompactGraph.h"
+#include "GraphAlgorithms.h"
+#include <cstdio>
+
+// Previous getMSTPrim: every round rescans the edges of the whole tree
+static long long quadraticPrimWeight(Graph* g) {
+    CompactGraph cg(g);
+    int size = cg.vertexCount();
+    bool* visited = new bool[size]();
+    visited[0] = true;
+    long long total = 0;
+    for (int added = 0; added < size - 1; ++added) {
+        int minWeight = GraphAlgorithms::INF;
+        int minSlot = -1;
+        for (int u = 0; u < size; ++u) {
+            if (!visited[u]) continue;
+            for (int s = cg.edgeBegin(u); s < cg.edgeEnd(u); ++s) {
+                if (!visited[cg.target(s)] && cg.weight(s) < minWeight) {
+                    minWeight = cg.weight(s);
+                    minSlot = s;
+                }
+            }
+        }
+        if (minSlot == -1) break;
+        visited[cg.target(minSlot)] = true;
+        total += minWeight;
+    }
+    delete[] visited;
+    return total;
+}
+
+static long long weightOf(LinkedList<Edge*>& edges) {
+    long long total = 0;
+    for (auto e : edges) total += e->weight;
+    return total;
+}
+
+static const int kQuadraticLimit = 5000;
+
+void benchMST() {
+    struct Case { int n; int epv; };
+    // Undirected: n * epv connections, the last two are ~1M edges
+    const Case cases[] = {{2000, 8}, {5000, 8}, {125000, 8}, {250000, 4}};
+    std::printf("       V  aristas  O(V*E)_ms  prim_ms  kruskal_ms  aristas_bosque\n");
+    for (const Case& c : cases) {
+        Graph* g = makeSyntheticGraph(c.n, c.epv, false);
+        long long edges = 0;
+        for (auto v : g->getVertices()) edges += v->edges.size();
+        edges /= 2;
+
+        double tOld = -1;
+        long long oldWeight = -1;
+        if (c.n <= kQuadraticLimit) {
+            Stopwatch sw;
+            oldWeight = quadraticPrimWeight(g);
+            tOld = sw.elapsedMs();
+        }
+
+        Stopwatch sw;
+        LinkedList<Edge*> prim = GraphAlgorithms::getMSTPrim(g);
+        double tPrim = sw.elapsedMs();
+        sw.reset();
+        LinkedList<Edge*> kruskal = GraphAlgorithms::getMSTKruskal(g);
+        double tKruskal = sw.elapsedMs();
+
+        bool same = weightOf(prim) == weightOf(kruskal) && prim.size() == kruskal.size();
+        // The old version stops at the first component, so only comparable when connected
+        if (oldWeight >= 0 && (int)prim.size() == c.n - 1) same = same && oldWeight == weightOf(prim);
+
+        if (tOld < 0) std::printf("%8d  %7lld  %9s", c.n, edges, "omitido");
+        else std::printf("%8d  %7lld  %9.0f", c.n, edges, tOld);
+        std::printf("  %7.1f  %10.1f  %14d%s\n", tPrim, tKruskal, (int)prim.size(),
+                    same ? "" : "  RESULTADOS DISTINTOS");
+        delete g;
+    }
+}
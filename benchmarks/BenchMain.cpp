@@ -0,0 +1,45 @@
+#include <iostream>
+#include <cstring>
+#include "Benchmarks.h"
+
+struct Suite {
+    const char* name;
+    void (*run)();
+};
+
+static const Suite suites[] = {
+    {"load", benchGraphLoad},
+    {"csr", benchCompactGraph},
+    {"dijkstra", benchDijkstra},
+    {"floyd", benchFloydWarshall},
+    {"apsp", benchAllPairs},
+    {"closure", benchClosure},
+    {"mst", benchMST},
+    {"closeness", benchCloseness},
+    {"memory", benchMemory},
+    {"lists", benchLists},
+    {"remove", benchRemoval},
+    {"files", benchFileFormats},
+    {"textparse", benchTextParser},
+    {"parload", benchParallelLoad},
+    {"save", benchSave},
+    {"compress", benchCompression},
+    {"edgeindex", benchSegmentIndex},
+};
+
+int main(int argc, char* argv[]) {
+    // Usage: GraphBenchmarks [suite...]   (no arguments runs everything)
+    int count = sizeof(suites) / sizeof(suites[0]);
+    for (int i = 0; i < count; ++i) {
+        bool selected = (argc < 2);
+        for (int a = 1; a < argc; ++a) {
+            if (std::strcmp(argv[a], suites[i].name) == 0) selected = true;
+        }
+        if (selected) {
+            std::cout << "== " << suites[i].name << " ==" << std::endl;
+            suites[i].run();
+            std::cout << std::endl;
+        }
+    }
+    return 0;
+}
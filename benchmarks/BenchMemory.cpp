@@ -0,0 +1,118 @@
+#include "Benchmarks.h"
+#include <cstdio>
+#ifdef __linux__
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+// Pre-pool Graph: one new/delete per Vertex, Edge and list node. Only used
+// as the "before" rows.
+class HeapGraph {
+public:
+    ~HeapGraph() { clear(); }
+
+    Vertex* addVertex(int id, const std::string& label, int x, int y) {
+        if (index.contains(id)) return nullptr;
+        Vertex* v = new Vertex(id, label, x, y);
+        vertices.push_back(v);
+        index.insert(id, v);
+        return v;
+    }
+
+    bool addEdge(int srcId, int destId, int weight) {
+        Vertex** src = index.find(srcId);
+        Vertex** dest = index.find(destId);
+        if (!src || !dest) return false;
+        for (auto e : (*src)->edges) {
+            if (e->dest == *dest) return false;
+        }
+        (*src)->edges.push_back(new Edge(*src, *dest, weight));
+        (*dest)->edges.push_back(new Edge(*dest, *src, weight));
+        return true;
+    }
+
+    void clear() {
+        for (auto v : vertices) {
+            for (auto e : v->edges) delete e;
+            delete v;
+        }
+        vertices.clear();
+        index.clear();
+    }
+
+private:
+    VertexList vertices;
+    HashMap<int, Vertex*> index;
+};
+
+// Resident set size of this process, 0 where /proc is not available
+static long residentKb() {
+    long pages = 0, resident = 0;
+    FILE* f = std::fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+    std::fclose(f);
+#ifdef __linux__
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+#else
+    return resident * 4;
+#endif
+}
+
+template <typename G>
+static void measure(const char* name, int n, int edgesPerVertex) {
+    int edgeCount;
+    SyntheticEdge* edges = makeSyntheticEdges(n, edgesPerVertex, 42, edgeCount);
+    long baseKb = residentKb();
+
+    Stopwatch sw;
+    G* g = new G(false, true);
+    for (int v = 1; v <= n; ++v) g->addVertex(v, "N" + std::to_string(v), v % 2000, v / 2000);
+    for (int i = 0; i < edgeCount; ++i) g->addEdge(edges[i].src, edges[i].dst, edges[i].weight);
+    double tLoad = sw.elapsedMs();
+    long loadedKb = residentKb();
+
+    sw.reset();
+    g->clear();
+    double tClear = sw.elapsedMs();
+
+    std::printf("%-8s  %8d  %9.0f  %9.1f  %8ld\n", name, n, tLoad, tClear, (loadedKb - baseKb) / 1024);
+    std::fflush(stdout);
+    delete g;
+    delete[] edges;
+}
+
+// Each measurement runs in its own process so the RSS of one variant isn't
+// hidden by memory the allocator kept from the previous one
+template <typename G>
+static void measureIsolated(const char* name, int n, int edgesPerVertex) {
+#ifdef __linux__
+    std::fflush(stdout); // or the child prints the parent's buffer again
+    pid_t pid = fork();
+    if (pid == 0) {
+        measure<G>(name, n, edgesPerVertex);
+        _exit(0);
+    }
+    if (pid > 0) {
+        int status;
+        waitpid(pid, &status, 0);
+        return;
+    }
+#endif
+    measure<G>(name, n, edgesPerVertex);
+}
+
+// HeapGraph mirrors Graph's (directed, weighted) constructor
+struct HeapGraphAdapter : HeapGraph {
+    HeapGraphAdapter(bool, bool) {}
+};
+
+void benchMemory() {
+    const int sizes[] = {100000, 200000, 400000};
+    const int edgesPerVertex = 5; // undirected: 2 Edge objects per connection
+    std::printf("variante  vertices  carga_ms  clear_ms  RSS_MB\n");
+    for (int n : sizes) {
+        measureIsolated<HeapGraphAdapter>("heap", n, edgesPerVertex);
+        measureIsolated<Graph>("pool", n, edgesPerVertex);
+    }
+}
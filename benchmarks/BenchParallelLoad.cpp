@@ -0,0 +1,36 @@
+#include "Benchmarks.h"
+#include "FileController.h"
+#include "ThreadPool.h"
+#include <cstdio>
+
+// Text load with the EDGES section parsed on 1..16 threads. Only the parse
+// and the vertex lookups run in parallel; adding the edges to the Graph is
+// the serial merge at the end.
+void benchParallelLoad() {
+    const int n = 1000000;
+    const int edgesPerVertex = 5;
+    std::string path = benchTempPath("bench_parallel_load.graph");
+    writeSyntheticGraphFile(path, n, edgesPerVertex, true);
+
+    std::printf("hilos  cargar_ms  aceleracion\n");
+    Stopwatch sw;
+    Graph* serial = FileController::loadGraph(path);
+    double base = sw.elapsedMs();
+    std::printf("%5s  %9.0f  %11s\n", "serie", base, "1.00x");
+    size_t edges = 0;
+    for (auto v : serial->getVertices()) edges += v->edges.size();
+    delete serial;
+
+    const int threadCounts[] = {1, 2, 4, 8, 16};
+    for (int threads : threadCounts) {
+        ThreadPool pool(threads);
+        sw.reset();
+        Graph* g = FileController::loadGraph(path, nullptr, &pool);
+        double t = sw.elapsedMs();
+        size_t loadedEdges = 0;
+        for (auto v : g->getVertices()) loadedEdges += v->edges.size();
+        std::printf("%5d  %9.0f  %10.2fx%s\n", threads, t, base / t, loadedEdges == edges ? "" : "  ERROR");
+        delete g;
+    }
+    std::remove(path.c_str());
+}
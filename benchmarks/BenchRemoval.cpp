@@ -0,0 +1,62 @@
+#include "Benchmarks.h"
+#include <cstdio>
+#include <random>
+
+// What the previous removeVertex paid on every call: a pass over every
+// edge of the graph looking for the ones that point at the vertex
+static double fullScanMs(Graph* g, Vertex* target, long long& found) {
+    Stopwatch sw;
+    found = 0;
+    for (auto v : g->getVertices()) {
+        for (auto e : v->edges) {
+            if (e->dest == target) found += e->weight + 1;
+        }
+    }
+    return sw.elapsedMs();
+}
+
+void benchRemoval() {
+    const int n = 200000;
+    const int removals = 2000;
+    Graph* g = makeSyntheticGraph(n, 5, false);
+    std::printf("grafo V=%d, 5 conexiones por vertice (no dirigido)\n", n);
+
+    long long found;
+    double scan = fullScanMs(g, g->getVertex(1), found);
+    std::printf("escaneo completo (coste anterior por vertice): %.1f ms -> %d vertices ~ %.0f ms (%lld)\n",
+                scan, removals, scan * removals, found);
+
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> pick(1, n);
+    Stopwatch sw;
+    int removed = 0;
+    while (removed < removals) {
+        if (g->removeVertex(pick(rng))) removed++;
+    }
+    std::printf("removeVertex x%d: %.1f ms\n", removals, sw.elapsedMs());
+
+    sw.reset();
+    int edgesRemoved = 0;
+    for (int i = 0; i < 100000; ++i) edgesRemoved += g->removeEdge(pick(rng), pick(rng)) ? 1 : 0;
+    for (auto v : g->getVertices()) {
+        if (v->edges.isEmpty()) continue;
+        g->removeEdge(v->edges.front());
+        edgesRemoved++;
+    }
+    std::printf("removeEdge x%d (por puntero y por IDs): %.1f ms\n", edgesRemoved, sw.elapsedMs());
+    delete g;
+
+    // One hub connected to everything
+    Graph star(true, false);
+    const int leaves = 20000; // addEdge checks the hub for duplicates: quadratic build
+    for (int i = 0; i <= leaves; ++i) star.addVertex(i, "", 0, 0);
+    for (int i = 1; i <= leaves; ++i) {
+        star.addEdge(0, i, 1);
+        star.addEdge(i, 0, 1);
+    }
+    scan = fullScanMs(&star, star.getVertex(0), found);
+    sw.reset();
+    star.removeVertex(0);
+    std::printf("hub con %d hojas (dirigido, ida y vuelta): removeVertex %.1f ms (escaneo anterior %.1f ms)\n",
+                leaves, sw.elapsedMs(), scan);
+}
@@ -0,0 +1,54 @@
+#include "Benchmarks.h"
+#include "FileController.h"
+#include <cstdio>
+#include <fstream>
+
+// The writer before the buffered one: operator<< per field and both
+// directions of every undirected edge. Only used as the "before" rows.
+static bool legacySave(Graph* graph, const std::string& filename) {
+    std::ofstream outfile(filename);
+    if (!outfile.is_open()) return false;
+    outfile << "TYPE:" << (graph->isDirected() ? "DIRECTED" : "UNDIRECTED") << "\n";
+    outfile << "WEIGHTED:" << (graph->isWeighted() ? "TRUE" : "FALSE") << "\n";
+    outfile << "NODES\n";
+    for (auto v : graph->getVertices()) {
+        outfile << v->id << "," << v->label << "," << v->x << "," << v->y << "\n";
+    }
+    outfile << "EDGES\n";
+    for (auto v : graph->getVertices()) {
+        for (auto e : v->edges) {
+            outfile << e->source->id << "," << e->dest->id << "," << e->weight << "\n";
+        }
+    }
+    return true;
+}
+
+static double fileMb(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    return in.is_open() ? in.tellg() / (1024.0 * 1024.0) : 0;
+}
+
+void benchSave() {
+    const int n = 1000000;
+    const int edgesPerVertex = 5;
+    std::string path = benchTempPath("bench_save.graph");
+    std::printf("grafo       escritor     archivo_MB  guardar_ms   MB/s\n");
+    for (int directed = 1; directed >= 0; --directed) {
+        Graph* g = makeSyntheticGraph(n, edgesPerVertex, directed == 1);
+        const char* kind = directed ? "dirigido" : "no dirigido";
+
+        Stopwatch sw;
+        legacySave(g, path);
+        double t = sw.elapsedMs();
+        double mb = fileMb(path);
+        std::printf("%-11s %-12s %10.1f  %10.0f  %5.0f\n", kind, "ofstream", mb, t, mb / (t / 1000));
+
+        sw.reset();
+        bool ok = FileController::saveGraph(g, path);
+        t = sw.elapsedMs();
+        mb = fileMb(path);
+        std::printf("%-11s %-12s %10.1f  %10.0f  %5.0f%s\n", kind, "to_chars", mb, t, mb / (t / 1000), ok ? "" : "  ERROR");
+        std::remove(path.c_str());
+        delete g;
+    }
+}
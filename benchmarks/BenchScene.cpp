@@ -0,0 +1,126 @@
+#include "Benchmarks.h"
+#include "GraphView.h"
+#include "VisualItems.h"
+#include <QApplication>
+#include <QGraphicsDropShadowEffect>
+#include <QGraphicsScene>
+#include <QImage>
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <cstdio>
+
+// Scene construction and repaint for 10k nodes, with the shared node
+// pixmaps (GraphView) against the per-item styling they replaced. Needs Qt,
+// so it is its own program rather than a GraphBenchmarks suite:
+//   ./build/SceneBenchmarks        (QT_QPA_PLATFORM=offscreen by default)
+
+// Reproduces the old VisualNode: its own gradient, drop shadow effect and
+// label. Only used as the "before" rows.
+class PerItemNode : public QGraphicsEllipseItem {
+public:
+    PerItemNode(Vertex* v) : label(QString::fromStdString(v->label)) {
+        setRect(-15, -15, 30, 30);
+        QRadialGradient gradient(0, 0, 15, -5, -5);
+        gradient.setColorAt(0, QColor(255, 255, 255));
+        gradient.setColorAt(1, QColor(200, 205, 210));
+        setBrush(gradient);
+        setPen(QPen(QColor(40, 42, 45, 180), 1.5));
+        setFlags(ItemIsMovable | ItemIsSelectable | ItemSendsGeometryChanges);
+
+        QGraphicsDropShadowEffect* shadow = new LodShadow();
+        shadow->setBlurRadius(15);
+        shadow->setOffset(0, 4);
+        shadow->setColor(QColor(0, 0, 0, 120));
+        setGraphicsEffect(shadow);
+        setPos(v->x, v->y);
+    }
+
+    QRectF boundingRect() const override {
+        return QGraphicsEllipseItem::boundingRect().adjusted(0, -20, 40, 0);
+    }
+
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget) override {
+        qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+        QGraphicsEllipseItem::paint(painter, option, widget);
+        if (lod >= kLodLabels) {
+            painter->setFont(nodeLabelFont());
+            painter->setPen(QColor(240, 240, 240));
+            painter->drawText(QPointF(-6, -22), label);
+        }
+    }
+
+private:
+    class LodShadow : public QGraphicsDropShadowEffect {
+    protected:
+        void draw(QPainter *painter) override {
+            qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+            if (lod < kLodShadows) drawSource(painter);
+            else QGraphicsDropShadowEffect::draw(painter);
+        }
+    };
+
+    QString label;
+};
+
+static const int kNodes = 10000;
+static const int kSpread = 5; // makeSyntheticGraph's 2000 x 2000 square, 5 times wider
+static const int kFrames = 10;
+
+static void reportRenders(const char* name, QGraphicsScene* scene, double build) {
+    QImage image(1280, 800, QImage::Format_ARGB32_Premultiplied);
+    struct View { const char* name; qreal zoom; };
+    // Whole graph (flat dots), labels without shadows, full detail
+    View views[] = {{"completa", 800.0 / (2000 * kSpread)}, {"50%", 0.5}, {"100%", 1.0}};
+    for (const View& view : views) {
+        qreal width = image.width() / view.zoom, height = image.height() / view.zoom;
+        QRectF source(1000 * kSpread - width / 2, 1000 * kSpread - height / 2, width, height);
+        double frames = 0;
+        for (int i = 0; i <= kFrames; ++i) {
+            image.fill(QColor(26, 28, 30));
+            Stopwatch sw;
+            QPainter painter(&image);
+            painter.setRenderHint(QPainter::Antialiasing);
+            scene->render(&painter, QRectF(image.rect()), source, Qt::IgnoreAspectRatio);
+            painter.end();
+            if (i > 0) frames += sw.elapsedMs(); // the first one fills the caches
+        }
+        std::printf("%-14s  %12.0f  %-8s  %9.2f\n", name, build, view.name, frames / kFrames);
+    }
+}
+
+static void benchScene() {
+    std::printf("estilo          construir_ms  vista     dibujo_ms\n");
+    {
+        Graph* g = makeSyntheticGraph(kNodes, 0, true);
+        for (auto v : g->getVertices()) {
+            v->x *= kSpread;
+            v->y *= kSpread;
+        }
+        Stopwatch sw;
+        QGraphicsScene scene;
+        for (auto v : g->getVertices()) scene.addItem(new PerItemNode(v));
+        double build = sw.elapsedMs();
+        reportRenders("por nodo", &scene, build);
+        delete g;
+    }
+    {
+        Graph* g = makeSyntheticGraph(kNodes, 0, true);
+        for (auto v : g->getVertices()) {
+            v->x *= kSpread;
+            v->y *= kSpread;
+        }
+        GraphView view;
+        Stopwatch sw;
+        view.setGraph(g); // the view owns it now
+        double build = sw.elapsedMs();
+        reportRenders("compartido", view.QGraphicsView::scene(), build);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+    std::printf("== scene ==\n");
+    benchScene();
+    return 0;
+}
@@ -0,0 +1,80 @@
+#include "Benchmarks.h"
+#include "SegmentIndex.h"
+#include <cstdio>
+
+// What the batched edge layer asks the index for: the edges in a viewport
+// (every repaint) and the edge under the mouse, against testing every edge.
+// The grid graph's edges are short; the random graph's cross the plane.
+void benchSegmentIndex() {
+    struct Case { const char* name; Graph* graph; };
+    Case cases[] = {
+        {"rejilla 700x700", makeGridGraph(700)},
+        {"aleatorio 100k x 5", makeSyntheticGraph(100000, 5, false)},
+    };
+    std::printf("grafo               aristas  construir_ms  vista  consulta_us  recorrido_us  visibles  punto_us\n");
+    for (Case& c : cases) {
+        Graph* g = c.graph;
+        // Random graphs have no layout: spread them over a square like the grid
+        int side = 1;
+        while ((long)side * side < (long)g->getVertices().size()) side++;
+        unsigned seed = 7;
+        for (auto v : g->getVertices()) {
+            if (v->x != 0 || v->y != 0) continue;
+            seed = seed * 1103515245u + 12345u;
+            v->x = (seed >> 8) % (side * 10);
+            seed = seed * 1103515245u + 12345u;
+            v->y = (seed >> 8) % (side * 10);
+        }
+
+        Stopwatch sw;
+        SegmentIndex index;
+        for (auto v : g->getVertices()) {
+            for (auto e : v->edges) {
+                if (e->twin && e->source->id > e->dest->id) continue; // one segment per undirected edge
+                index.add(v->x, v->y, e->dest->x, e->dest->y);
+            }
+        }
+        double build = sw.elapsedMs();
+        float extent = side * 10.0f;
+
+        // Viewports from zoomed in to everything in view
+        float views[] = {200, 1000, extent / 4, extent};
+        for (float view : views) {
+            const int queries = view < extent / 4 ? 2000 : 20;
+            long found = 0;
+            sw.reset();
+            for (int q = 0; q < queries; ++q) {
+                float left = (float)((q * 7919) % (int)extent) - view / 2, top = (float)((q * 104729) % (int)extent) - view / 2;
+                index.query(left, top, left + view, top + view, [&](int) { found++; });
+            }
+            double indexed = sw.elapsedMs() * 1000 / queries;
+
+            long scanned = 0;
+            sw.reset();
+            for (int q = 0; q < queries; ++q) {
+                float left = (float)((q * 7919) % (int)extent) - view / 2, top = (float)((q * 104729) % (int)extent) - view / 2;
+                for (int id = 0; id < index.slotCount(); ++id) {
+                    const float* s = index.segment(id);
+                    if (std::min(s[0], s[2]) <= left + view && std::max(s[0], s[2]) >= left &&
+                        std::min(s[1], s[3]) <= top + view && std::max(s[1], s[3]) >= top) {
+                        scanned++;
+                    }
+                }
+            }
+            double linear = sw.elapsedMs() * 1000 / queries;
+
+            // As many as fit in about 100 ms
+            int points = 0;
+            sw.reset();
+            while (points < 20000 && sw.elapsedMs() < 100) {
+                index.nearest((float)((points * 7919) % (int)extent), (float)((points * 104729) % (int)extent), 4);
+                points++;
+            }
+            double point = sw.elapsedMs() * 1000 / points;
+
+            std::printf("%-18s  %7d  %12.0f  %5.0f  %11.1f  %12.1f  %8ld  %8.2f%s\n", c.name, index.size(), build, view,
+                        indexed, linear, found / queries, point, found == scanned ? "" : "  ERROR");
+        }
+        delete g;
+    }
+}
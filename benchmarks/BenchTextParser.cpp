@@ -0,0 +1,112 @@
+#include "Benchmarks.h"
+#include "FileController.h"
+#include "GraphTextParser.h"
+#include "MappedFile.h"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+// The loader before GraphTextParser: getline, a stringstream per line and
+// std::stoi per field. Only used as the "before" rows.
+static Graph* legacyLoad(const std::string& filename, bool buildGraph, long long& checksum) {
+    std::ifstream infile(filename);
+    if (!infile.is_open()) return nullptr;
+    std::string line;
+    std::getline(infile, line);
+    bool directed = line.find("DIRECTED") != std::string::npos;
+    std::getline(infile, line);
+    bool weighted = line.find("WEIGHTED:TRUE") != std::string::npos;
+    Graph* graph = buildGraph ? new Graph(directed, weighted) : nullptr;
+
+    std::string section;
+    while (std::getline(infile, line)) {
+        if (line == "NODES" || line == "EDGES") { section = line; continue; }
+        std::stringstream ss(line);
+        std::string segment;
+        std::string parts[4];
+        int i = 0;
+        int wanted = section == "NODES" ? 4 : 3;
+        while (i < wanted && std::getline(ss, segment, ',')) parts[i++] = segment;
+        if (i < wanted) continue;
+        if (section == "NODES") {
+            int id = std::stoi(parts[0]), x = std::stoi(parts[2]), y = std::stoi(parts[3]);
+            checksum += id + x + y;
+            if (graph) graph->addVertex(id, parts[1], x, y);
+        } else {
+            int src = std::stoi(parts[0]), dest = std::stoi(parts[1]), w = std::stoi(parts[2]);
+            checksum += src + dest + w;
+            if (graph) graph->addEdge(src, dest, w);
+        }
+    }
+    return graph;
+}
+
+// Tokenizing only, with the same line functions GraphTextParser uses
+static long long scanOnly(const std::string& path) {
+    MappedFile file;
+    if (!file.open(path)) return 0;
+    const char* p = file.data();
+    const char* limit = p + file.size();
+    long long checksum = 0;
+    bool edges = false;
+    while (p < limit) {
+        const char* newline = (const char*)std::memchr(p, '\n', (size_t)(limit - p));
+        const char* end = newline ? newline : limit;
+        const char* begin = p;
+        p = newline ? newline + 1 : limit;
+        if (end - begin == 5 && std::memcmp(begin, "EDGES", 5) == 0) { edges = true; continue; }
+        int a, b, c;
+        if (edges) {
+            if (!GraphTextParser::parseEdgeLine(begin, end, a, b, c)) checksum += a + b + c;
+        } else {
+            const char* label;
+            size_t labelLength;
+            if (!GraphTextParser::parseNodeLine(begin, end, a, label, labelLength, b, c)) checksum += a + b + c;
+        }
+    }
+    return checksum;
+}
+
+void benchTextParser() {
+    const int n = 1000000;
+    const int edgesPerVertex = 5;
+    std::string path = benchTempPath("bench_textparse.graph");
+    writeSyntheticGraphFile(path, n, edgesPerVertex, true);
+    double mb;
+    {
+        MappedFile file;
+        file.open(path);
+        mb = file.size() / (1024.0 * 1024.0);
+    }
+    std::printf("archivo: %d vertices, %.1f MB\n", n, mb);
+    std::printf("lector                      ms      MB/s  checksum\n");
+
+    long long legacySum = 0;
+    Stopwatch sw;
+    legacyLoad(path, false, legacySum);
+    double t = sw.elapsedMs();
+    std::printf("%-22s  %8.0f  %8.0f  %lld\n", "getline+stoi (solo)", t, mb / (t / 1000), legacySum);
+
+    sw.reset();
+    long long scanSum = scanOnly(path);
+    t = sw.elapsedMs();
+    std::printf("%-22s  %8.0f  %8.0f  %lld%s\n", "from_chars (solo)", t, mb / (t / 1000), scanSum,
+                scanSum == legacySum ? "" : "  ERROR");
+
+    legacySum = 0;
+    sw.reset();
+    Graph* before = legacyLoad(path, true, legacySum);
+    t = sw.elapsedMs();
+    std::printf("%-22s  %8.0f  %8.0f\n", "getline+stoi + grafo", t, mb / (t / 1000));
+
+    sw.reset();
+    std::string problems;
+    Graph* after = FileController::loadGraph(path, &problems);
+    t = sw.elapsedMs();
+    bool same = after && before && after->getVertices().size() == before->getVertices().size() && problems.empty();
+    std::printf("%-22s  %8.0f  %8.0f%s\n", "GraphTextParser + grafo", t, mb / (t / 1000), same ? "" : "  ERROR");
+    delete before;
+    delete after;
+    std::remove(path.c_str());
+}
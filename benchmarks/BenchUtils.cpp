@@ -0,0 +1,87 @@
+#include "Benchmarks.h"
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <random>
+
+SyntheticEdge* makeSyntheticEdges(int n, int edgesPerVertex, unsigned seed, int& edgeCount) {
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> target(1, n);
+    std::uniform_int_distribution<int> weight(1, 100);
+
+    edgeCount = n * edgesPerVertex;
+    SyntheticEdge* edges = new SyntheticEdge[edgeCount];
+    int k = 0;
+    for (int v = 1; v <= n; ++v) {
+        for (int j = 0; j < edgesPerVertex; ++j) {
+            edges[k++] = {v, target(rng), weight(rng)};
+        }
+    }
+    return edges;
+}
+
+Graph* makeSyntheticGraph(int n, int edgesPerVertex, bool directed, unsigned seed) {
+    Graph* g = new Graph(directed, true);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> coord(0, 2000);
+    for (int v = 1; v <= n; ++v) {
+        g->addVertex(v, "N" + std::to_string(v), coord(rng), coord(rng));
+    }
+    int edgeCount;
+    SyntheticEdge* edges = makeSyntheticEdges(n, edgesPerVertex, seed, edgeCount);
+    for (int i = 0; i < edgeCount; ++i) {
+        g->addEdge(edges[i].src, edges[i].dst, edges[i].weight);
+    }
+    delete[] edges;
+    return g;
+}
+
+Graph* makeGridGraph(int side, unsigned seed) {
+    Graph* g = new Graph(false, true);
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> weight(10, 30);
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            g->addVertex(1 + r * side + c, "", c * 10, r * 10);
+        }
+    }
+    for (int r = 0; r < side; ++r) {
+        for (int c = 0; c < side; ++c) {
+            int id = 1 + r * side + c;
+            if (c + 1 < side) g->addEdge(id, id + 1, weight(rng));
+            if (r + 1 < side) g->addEdge(id, id + side, weight(rng));
+        }
+    }
+    return g;
+}
+
+bool writeSyntheticGraphFile(const std::string& path, int n, int edgesPerVertex, bool directed, unsigned seed) {
+    std::ofstream out(path);
+    if (!out.is_open()) return false;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> coord(0, 2000);
+
+    out << "TYPE:" << (directed ? "DIRECTED" : "UNDIRECTED") << "\n";
+    out << "WEIGHTED:TRUE\n";
+    out << "NODES\n";
+    for (int v = 1; v <= n; ++v) {
+        out << v << ",N" << v << "," << coord(rng) << "," << coord(rng) << "\n";
+    }
+    out << "EDGES\n";
+    int edgeCount;
+    SyntheticEdge* edges = makeSyntheticEdges(n, edgesPerVertex, seed, edgeCount);
+    for (int i = 0; i < edgeCount; ++i) {
+        out << edges[i].src << "," << edges[i].dst << "," << edges[i].weight << "\n";
+    }
+    delete[] edges;
+    return true;
+}
+
+std::string benchTempPath(const std::string& name) {
+#ifdef _WIN32
+    const char* dir = std::getenv("TEMP");
+    return std::string(dir ? dir : ".") + "\\" + name;
+#else
+    return "/tmp/" + name;
+#endif
+}
@@ -0,0 +1,53 @@
+#ifndef BENCHMARKS_H
+#define BENCHMARKS_H
+
+#include "Graph.h"
+#include <chrono>
+#include <string>
+
+// Wall-clock timer used by every benchmark
+class Stopwatch {
+public:
+    Stopwatch() { reset(); }
+    void reset() { start = std::chrono::steady_clock::now(); }
+    double elapsedMs() const {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+// Synthetic inputs shared by the suites. IDs are 1..n, each vertex gets
+// `edgesPerVertex` edges to random targets (duplicates are skipped by Graph).
+struct SyntheticEdge { int src, dst, weight; };
+
+SyntheticEdge* makeSyntheticEdges(int n, int edgesPerVertex, unsigned seed, int& edgeCount);
+Graph* makeSyntheticGraph(int n, int edgesPerVertex, bool directed, unsigned seed = 42);
+// side x side grid with 4-neighbour undirected edges, like a road network.
+// Vertex IDs are 1 + row * side + col, coordinates are 10 units per cell and
+// weights are >= the Euclidean length of each edge.
+Graph* makeGridGraph(int side, unsigned seed = 42);
+bool writeSyntheticGraphFile(const std::string& path, int n, int edgesPerVertex, bool directed, unsigned seed = 42);
+std::string benchTempPath(const std::string& name);
+
+// Suites (one per file)
+void benchGraphLoad();
+void benchCompactGraph();
+void benchDijkstra();
+void benchFloydWarshall();
+void benchAllPairs();
+void benchClosure();
+void benchMST();
+void benchCloseness();
+void benchMemory();
+void benchLists();
+void benchRemoval();
+void benchFileFormats();
+void benchTextParser();
+void benchParallelLoad();
+void benchSave();
+void benchCompression();
+void benchSegmentIndex();
+
+#endif // BENCHMARKS_H
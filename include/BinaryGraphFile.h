@@ -0,0 +1,111 @@
+#ifndef BINARYGRAPHFILE_H
+#define BINARYGRAPHFILE_H
+
+#include "Graph.h"
+#include "MappedFile.h"
+#include <cstdint>
+#include <string>
+
+// Binary graph file (".graphb"), native little-endian. Every section starts
+// at a multiple of 8 bytes so the arrays can be used in place from a mapping:
+//
+//   BinaryGraphHeader
+//   vertex table   vertexCount x BinaryVertexRecord
+//   string pool    labels back to back (not NUL-terminated)
+//   offsets        (vertexCount + 1) x int32, CSR row starts
+//   targets        edgeCount x int32, dense index of each edge's destination
+//   weights        edgeCount x int32
+//
+// Edges are the CSR slots of the graph (as in CompactGraph), so undirected
+// connections are stored in both directions. Bump the version whenever the
+// layout changes; readers reject versions they don't know.
+static const char kBinaryGraphMagic[8] = {'V', 'G', 'R', 'A', 'F', 'O', 'B', '\0'};
+static const uint32_t kBinaryGraphVersion = 1;
+static const uint32_t kBinaryGraphByteOrder = 0x01020304; // reads differently on a foreign-endian host
+
+enum BinaryGraphFlags : uint32_t {
+    BinaryGraphDirected = 1u << 0,
+    BinaryGraphWeighted = 1u << 1
+};
+
+struct BinaryGraphHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteOrder;
+    uint32_t flags;
+    uint32_t reserved;
+    uint64_t vertexCount;
+    uint64_t edgeCount;
+    uint64_t vertexTableOffset;
+    uint64_t stringPoolOffset;
+    uint64_t stringPoolBytes;
+    uint64_t offsetsOffset;
+    uint64_t targetsOffset;
+    uint64_t weightsOffset;
+    uint64_t fileSize;
+};
+
+struct BinaryVertexRecord {
+    int32_t id;
+    int32_t x;
+    int32_t y;
+    uint32_t labelLength;
+    uint64_t labelOffset; // into the string pool
+};
+
+static_assert(sizeof(BinaryGraphHeader) == 96, "header layout is part of the file format");
+static_assert(sizeof(BinaryVertexRecord) == 24, "vertex record layout is part of the file format");
+
+// A mapped, validated .graphb file. The accessors read straight from the
+// mapping (zero copy); toGraph() bulk-copies it into a Graph for editing.
+class BinaryGraphFile {
+public:
+    BinaryGraphFile();
+
+    // Maps the file and checks magic, version, byte order, that every
+    // section and index is in bounds and that the CSR is a graph's (no
+    // repeated edges; undirected, each edge stored both ways). On failure
+    // error() says why.
+    bool open(const std::string& path);
+    void close();
+    const std::string& error() const { return message; }
+
+    int vertexCount() const { return (int)header->vertexCount; }
+    int edgeCount() const { return (int)header->edgeCount; }
+    bool isDirected() const { return (header->flags & BinaryGraphDirected) != 0; }
+    bool isWeighted() const { return (header->flags & BinaryGraphWeighted) != 0; }
+
+    int idAt(int i) const { return vertexTable[i].id; }
+    int xAt(int i) const { return vertexTable[i].x; }
+    int yAt(int i) const { return vertexTable[i].y; }
+    std::string labelAt(int i) const {
+        return std::string(stringPool + vertexTable[i].labelOffset, vertexTable[i].labelLength);
+    }
+
+    // CSR arrays, same meaning as CompactGraph's
+    const int32_t* offsetArray() const { return offsets; }
+    const int32_t* targetArray() const { return targets; }
+    const int32_t* weightArray() const { return weights; }
+
+    // New Graph with the file's contents (caller deletes), nullptr if the
+    // file repeats a vertex ID
+    Graph* toGraph() const;
+
+    // True if the bytes start with the .graphb magic
+    static bool hasMagic(const char* data, size_t size);
+    static bool write(Graph* graph, const std::string& path);
+
+private:
+    bool fail(const std::string& why);
+
+    MappedFile file;
+    std::string message;
+    const BinaryGraphHeader* header;
+    const BinaryVertexRecord* vertexTable;
+    const char* stringPool;
+    const int32_t* offsets;
+    const int32_t* targets;
+    const int32_t* weights;
+};
+
+#endif // BINARYGRAPHFILE_H
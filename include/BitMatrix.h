@@ -0,0 +1,66 @@
+#ifndef BITMATRIX_H
+#define BITMATRIX_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Square boolean matrix stored as bitsets: row i is wordsPerRow() 64-bit
+// words in one contiguous block (1 bit per pair instead of 1 byte, and no
+// per-row allocations). Whole-row OR is what transitive closure needs.
+class BitMatrix {
+public:
+    explicit BitMatrix(int n) : n(n) {
+        // Rows padded to 4 words (256 bits) so orRow has no scalar tail
+        words = ((n + 255) / 256) * 4;
+        size_t total = (size_t)words * (n > 0 ? n : 1);
+        bits = new uint64_t[total];
+        for (size_t i = 0; i < total; ++i) bits[i] = 0;
+    }
+
+    ~BitMatrix() {
+        delete[] bits;
+    }
+
+    BitMatrix(const BitMatrix&) = delete;
+    BitMatrix& operator=(const BitMatrix&) = delete;
+
+    int size() const { return n; }
+    int wordsPerRow() const { return words; }
+
+    bool get(int i, int j) const {
+        return (bits[(size_t)i * words + (j >> 6)] >> (j & 63)) & 1;
+    }
+
+    void set(int i, int j) {
+        bits[(size_t)i * words + (j >> 6)] |= (uint64_t)1 << (j & 63);
+    }
+
+    uint64_t* row(int i) { return bits + (size_t)i * words; }
+    const uint64_t* row(int i) const { return bits + (size_t)i * words; }
+
+    // row[dst] |= row[src]; plain word loop the compiler turns into SIMD ORs
+    void orRow(int dst, int src) {
+        if (dst == src) return;
+        uint64_t* __restrict d = row(dst);
+        const uint64_t* __restrict s = row(src);
+        for (int w = 0; w < words; w += 4) {
+            d[w] |= s[w];
+            d[w + 1] |= s[w + 1];
+            d[w + 2] |= s[w + 2];
+            d[w + 3] |= s[w + 3];
+        }
+    }
+
+    void copyRow(int dst, int src) {
+        uint64_t* d = row(dst);
+        const uint64_t* s = row(src);
+        for (int w = 0; w < words; ++w) d[w] = s[w];
+    }
+
+private:
+    int n;
+    int words;
+    uint64_t* bits;
+};
+
+#endif // BITMATRIX_H
@@ -0,0 +1,91 @@
+#ifndef COMPACTGRAPH_H
+#define COMPACTGRAPH_H
+
+#include "Graph.h"
+#include "HashMap.h"
+#include <atomic>
+
+// Immutable CSR (compressed sparse row) snapshot of a Graph.
+// Vertices get dense indices 0..N-1 in the order of Graph::getVertices(), and
+// the out-edges of vertex i are the slots offsets[i] .. offsets[i+1]-1 of the
+// targets/weights/edges arrays. Algorithms build one snapshot per call and
+// then never touch the pointer-based structure again.
+// The snapshot is only valid while the source graph is not modified.
+// With `withReverse` the transposed adjacency (in-edges) is built as well, for
+// searches that walk edges backwards (bidirectional Dijkstra).
+class CompactGraph {
+public:
+    explicit CompactGraph(Graph* graph, bool withReverse = false);
+    ~CompactGraph();
+
+    CompactGraph(const CompactGraph&) = delete;
+    CompactGraph& operator=(const CompactGraph&) = delete;
+
+    int vertexCount() const { return n; }
+    int edgeCount() const { return m; }
+    bool isDirected() const { return directed; }
+    bool isWeighted() const { return weighted; }
+
+    // Dense index for a vertex ID, -1 if the ID is not in the graph
+    int indexOf(int id) const;
+    int idAt(int i) const { return ids[i]; }
+    Vertex* vertexAt(int i) const { return vertices[i]; }
+    int xAt(int i) const { return xs[i]; }
+    int yAt(int i) const { return ys[i]; }
+
+    // Edge slots of vertex i are [edgeBegin(i), edgeEnd(i))
+    int edgeBegin(int i) const { return offsets[i]; }
+    int edgeEnd(int i) const { return offsets[i + 1]; }
+    int target(int slot) const { return targets[slot]; }
+    int weight(int slot) const { return weights[slot]; }
+    Edge* edgeAt(int slot) const { return edges[slot]; }
+
+    // Raw arrays for tight loops
+    const int* offsetArray() const { return offsets; }
+    const int* targetArray() const { return targets; }
+    const int* weightArray() const { return weights; }
+
+    // Smallest weight / straight-line length over the edges, for scaling the
+    // A* heuristic; 0 if any weight is negative or no edge has a length.
+    // Worked out on the first call (one pass over the edges) and kept, so
+    // queries on the same snapshot only read it.
+    double minWeightPerLength() const;
+
+    // In-edges of vertex i are [reverseOffsetArray()[i], reverseOffsetArray()[i+1]).
+    // reverseSlotArray() maps each one to its forward slot (for edgeAt/target).
+    bool hasReverse() const { return revOffsets != nullptr; }
+    const int* reverseOffsetArray() const { return revOffsets; }
+    const int* reverseSourceArray() const { return revSources; }
+    const int* reverseWeightArray() const { return revWeights; }
+    const int* reverseSlotArray() const { return revSlots; }
+
+    // Caller-owned copy of the index -> ID table (delete[] when done), for the
+    // GraphAlgorithms functions that hand an idMap back to the GUI
+    int* copyIdMap() const;
+
+private:
+    void buildReverse();
+
+    int n;
+    int m;
+    bool directed;
+    bool weighted;
+
+    int* offsets;      // n + 1
+    int* targets;      // m, dense index of the destination
+    int* weights;      // m
+    Edge** edges;      // m, original Edge for results (paths, MST)
+    int* ids;          // n
+    Vertex** vertices; // n
+    int* xs;           // n, GUI coordinates (A* heuristic)
+    int* ys;           // n
+
+    int* revOffsets;   // n + 1, only with withReverse
+    int* revSources;   // m
+    int* revWeights;   // m
+    int* revSlots;     // m
+    HashMap<int, int> indexById;
+    mutable std::atomic<double> weightPerLength; // < 0 until first asked for
+};
+
+#endif // COMPACTGRAPH_H
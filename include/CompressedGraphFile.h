@@ -0,0 +1,98 @@
+#ifndef COMPRESSEDGRAPHFILE_H
+#define COMPRESSEDGRAPHFILE_H
+
+#include "Graph.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Compressed graph file (".graphz"): a fixed header followed by a stream of
+// LEB128 varints, for archiving big sparse graphs whose neighbours have
+// nearby IDs.
+//
+//   CompressedGraphHeader
+//   per vertex     zigzag(id - previous id), zigzag(x), zigzag(y),
+//                  label length, label bytes
+//   per vertex u   degree, then the neighbour indices sorted ascending:
+//                  the first as zigzag(v - u), the rest as gaps (v - previous)
+//                  and, when the flag is set, zigzag(weight) after each one
+//
+// Neighbours are dense vertex indices (file order), as in CompactGraph. An
+// undirected connection is stored once, from its lower-indexed end.
+static const char kCompressedGraphMagic[8] = {'V', 'G', 'R', 'A', 'F', 'O', 'Z', '\0'};
+static const uint32_t kCompressedGraphVersion = 1;
+
+enum CompressedGraphFlags : uint32_t {
+    CompressedGraphDirected = 1u << 0,
+    CompressedGraphWeighted = 1u << 1,
+    CompressedGraphHasWeights = 1u << 2 // off when every weight is 1
+};
+
+struct CompressedGraphHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t flags;
+    uint64_t vertexCount;
+    uint64_t edgeCount; // stored edges (undirected ones once)
+    uint64_t fileSize;
+};
+
+static_assert(sizeof(CompressedGraphHeader) == 40, "header layout is part of the file format");
+
+// A decoded .graphz file held as flat arrays (CSR in file order), plus the
+// encoder. Decoding checks every read against the end of the data, so a
+// damaged file is rejected instead of read out of bounds.
+class CompressedGraphFile {
+public:
+    CompressedGraphFile();
+    ~CompressedGraphFile();
+
+    CompressedGraphFile(const CompressedGraphFile&) = delete;
+    CompressedGraphFile& operator=(const CompressedGraphFile&) = delete;
+
+    // Decodes the bytes of a whole file. On failure error() says why.
+    bool decode(const char* data, size_t size);
+    bool open(const std::string& path);
+    void clear();
+    const std::string& error() const { return message; }
+
+    int vertexCount() const { return n; }
+    int edgeCount() const { return m; }
+    bool isDirected() const { return directed; }
+    bool isWeighted() const { return weighted; }
+
+    int idAt(int i) const { return ids[i]; }
+    int xAt(int i) const { return xs[i]; }
+    int yAt(int i) const { return ys[i]; }
+    const std::string& labelAt(int i) const { return labels[i]; }
+
+    // Stored edges of vertex i are [offsetArray()[i], offsetArray()[i + 1])
+    const int32_t* offsetArray() const { return offsets; }
+    const int32_t* targetArray() const { return targets; }
+    const int32_t* weightArray() const { return weights; }
+
+    // New Graph with the decoded contents (caller deletes), nullptr if the
+    // file repeats a vertex ID
+    Graph* toGraph() const;
+
+    static bool hasMagic(const char* data, size_t size);
+    static bool write(Graph* graph, const std::string& path);
+
+private:
+    bool fail(const std::string& why);
+
+    std::string message;
+    int n;
+    int m;
+    bool directed;
+    bool weighted;
+    int32_t* ids;
+    int32_t* xs;
+    int32_t* ys;
+    std::string* labels;
+    int32_t* offsets;
+    int32_t* targets;
+    int32_t* weights;
+};
+
+#endif // COMPRESSEDGRAPHFILE_H
@@ -0,0 +1,72 @@
+#ifndef EDGELAYER_H
+#define EDGELAYER_H
+
+#include <QGraphicsItem>
+#include <QVector>
+#include <QLineF>
+#include "Graph.h"
+#include "SegmentIndex.h"
+#include "UnrolledList.h"
+
+class VisualNode;
+
+// Every edge of the scene drawn by one item, for graphs too big for one
+// VisualEdge per edge (GraphView::setBatchedEdges). The segments live in a
+// SegmentIndex: painting draws only those crossing the exposed rect, in two
+// drawLines calls (normal and highlighted), and edgeAt() hit-tests through
+// it. Each edge is known by its slot, the id returned by addEdge.
+class EdgeLayer : public QGraphicsItem {
+public:
+    EdgeLayer();
+    ~EdgeLayer();
+
+    int addEdge(Edge* e, VisualNode* src, VisualNode* dest);
+    void removeEdge(int slot);
+    Edge* edgeOf(int slot) const { return entries[slot].edge; }
+
+    // Reads the endpoints' positions again
+    void refresh(int slot);
+    // Same, deferred until flushMoved(), once per slot however many times
+    // it is marked
+    void markMoved(int slot);
+    void flushMoved();
+
+    void setHighlighted(int slot, bool high);
+    void clearHighlights();
+
+    // Edge whose line passes within `tolerance` of the point, or nullptr
+    Edge* edgeAt(const QPointF& pos, qreal tolerance) const;
+    bool contains(const QPointF& point) const override;
+
+    QRectF boundingRect() const override;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = nullptr) override;
+
+    enum { Type = UserType + 3 };
+    int type() const override { return Type; }
+
+private:
+    struct Slot {
+        Edge* edge;
+        VisualNode* source;
+        VisualNode* dest;
+        bool highlighted;
+        bool moved; // waiting in movedSlots
+    };
+
+    void place(int slot); // endpoints into the index, growing the bounds
+    QRectF segmentRect(int slot) const;
+
+    SegmentIndex index;
+    Slot* entries; // by SegmentIndex id
+    int capacity;
+    UnrolledList<int, 32> movedSlots;
+    UnrolledList<int, 32> highlightedSlots;
+    QRectF bounds; // grows only, until the layer is deleted
+
+    // Reused by paint
+    QVector<QLineF> normalLines;
+    QVector<QLineF> highlightedLines;
+    QVector<int> visible;
+};
+
+#endif // EDGELAYER_H
@@ -4,10 +4,29 @@
 #include "Graph.h"
 #include <string>
 
+class ThreadPool;
+
+// On-disk formats. Text is the original line-based ".graph"; Binary is the
+// mmap-able ".graphb" described in BinaryGraphFile.h; Compressed is the
+// delta + varint ".graphz" described in CompressedGraphFile.h.
+enum class GraphFileFormat {
+    Text,
+    Binary,
+    Compressed
+};
+
 class FileController {
 public:
-    static bool saveGraph(Graph* graph, const std::string& filename);
-    static Graph* loadGraph(const std::string& filename);
+    static bool saveGraph(Graph* graph, const std::string& filename, GraphFileFormat format = GraphFileFormat::Text);
+    // Detects the format from the file's first bytes. Malformed lines of a
+    // text file are skipped; if `problems` is given it receives one
+    // "línea N: ..." entry per skipped line (empty when the file was clean).
+    // With a pool, the EDGES section of a large text file is parsed in
+    // parallel (see GraphTextParser::parse); nullptr loads on this thread.
+    static Graph* loadGraph(const std::string& filename, std::string* problems = nullptr, ThreadPool* pool = nullptr);
+    // Format implied by the file name's extension (".graphb" = Binary,
+    // ".graphz" = Compressed, anything else Text)
+    static GraphFileFormat formatForFileName(const std::string& filename);
 };
 
 #endif // FILECONTROLLER_H
@@ -0,0 +1,35 @@
+#ifndef FLOYDWARSHALL_H
+#define FLOYDWARSHALL_H
+
+// Dense all-pairs distance matrices and the Floyd-Warshall kernels that work
+// on them. A matrix is one contiguous 64-byte aligned block; the int** handed
+// out only points into it (row i = block + i * stride), so existing
+// matrix[i][j] code keeps working. Release with freeDistanceMatrix.
+
+// Inner "min-plus" loop: row[j] = min(row[j], dik + rowK[j]) over a range.
+// Picked at runtime from what the CPU supports.
+enum class MinPlusKernel {
+    Scalar,
+    SSE41,
+    AVX2
+};
+
+MinPlusKernel bestMinPlusKernel();
+const char* minPlusKernelName(MinPlusKernel kernel);
+
+// Row stride (ints) used for an n x n matrix: n rounded up to 16
+int distanceMatrixStride(int n);
+int** allocDistanceMatrix(int n); // throws std::bad_alloc like new[]
+void freeDistanceMatrix(int** matrix);
+
+class ThreadPool;
+
+// `inf` means "no path" and must be <= INT_MAX / 2; entries are <= inf
+// (weights may be negative). Distances below inf are exact, a path of inf or
+// more reads as no path.
+void floydWarshallNaive(int** dist, int n, int inf);
+// With a pool, the independent tiles of phases 2 and 3 of every k-round are
+// spread across its workers
+void floydWarshallBlocked(int** dist, int n, int inf, MinPlusKernel kernel, ThreadPool* pool = nullptr);
+
+#endif // FLOYDWARSHALL_H
@@ -2,17 +2,28 @@
 #define GRAPH_H
 
 #include "LinkedList.h"
+#include "UnrolledList.h"
+#include "HashMap.h"
+#include "ObjectPool.h"
 #include <string>
 
 struct Edge; 
+struct Vertex;
+
+// Adjacency and vertex storage: unrolled lists (see UnrolledList.h). Most
+// vertices have a handful of edges, so edge chunks are small.
+typedef UnrolledList<Edge*, 8> EdgeList;
+typedef UnrolledList<Vertex*, 32> VertexList;
 
 struct Vertex {
     int id;
     std::string label;
     int x, y; // GUI coordinates
-    LinkedList<Edge*> edges; // Adjacency list
+    EdgeList edges;    // Adjacency list (out-edges)
+    EdgeList incoming; // Edges whose dest is this vertex, for O(degree) removal
+    VertexList::Position listPos; // slot in Graph::vertices
 
-    Vertex(int id, std::string label, int x, int y);
+    Vertex(int id, std::string label, int x, int y, ObjectPool<EdgeList::Chunk>* edgeChunks = nullptr);
 };
 
 struct Edge {
@@ -20,6 +31,11 @@ struct Edge {
     Vertex* dest;
     int weight;
     bool isDirected;
+    // Where this edge sits in source->edges and dest->incoming, so it can be
+    // unlinked in O(1). In undirected graphs `twin` is the reverse copy.
+    EdgeList::Position outPos;
+    EdgeList::Position inPos;
+    Edge* twin;
 
     Edge(Vertex* src, Vertex* dst, int w);
 };
@@ -31,18 +47,42 @@ public:
 
     Vertex* addVertex(int id, const std::string& label, int x, int y);
     bool addEdge(int srcId, int destId, int weight = 1);
+    Edge* addEdge(Vertex* src, Vertex* dest, int weight); // same, vertices already looked up; nullptr if it exists
+    // Bulk-load path for file readers: no lookups and no duplicate check,
+    // the caller guarantees src -> dest is not in the graph yet. Adds the
+    // reverse edge (twin) on undirected graphs like addEdge.
+    Edge* appendEdge(Vertex* src, Vertex* dest, int weight);
+    // Pre-size the ID index before adding `vertexCount` vertices
+    void reserve(int vertexCount);
     bool removeVertex(int id);
     bool removeEdge(int srcId, int destId);
+    bool removeEdge(Edge* edge); // O(1), removes the twin as well
     Vertex* getVertex(int id);
+    Edge* getEdge(int srcId, int destId); // O(out-degree of the source)
     
-    LinkedList<Vertex*>& getVertices();
+    VertexList& getVertices();
+    // Entries of all adjacency lists, so each undirected edge counts twice
+    size_t edgeCount() const;
     void clear();
 
     bool isDirected() const;
     bool isWeighted() const;
 
 private:
-    LinkedList<Vertex*> vertices;
+    Edge* linkEdge(Vertex* src, Vertex* dest, int weight);
+    void unlinkEdge(Edge* e);
+
+    // Every Vertex, Edge and list chunk of the graph lives in these pools, so
+    // clear() releases them slab by slab instead of one object at a time.
+    // Declared before the lists that use them (destroyed after).
+    ObjectPool<Vertex> vertexPool;
+    ObjectPool<Edge> edgePool;
+    ObjectPool<VertexList::Chunk> vertexChunkPool;
+    ObjectPool<EdgeList::Chunk> edgeChunkPool;
+
+    VertexList vertices;
+    HashMap<int, Vertex*> index; // id -> Vertex, O(1) expected lookup
+    size_t edgeTotal;
     bool directed;
     bool weighted;
 };
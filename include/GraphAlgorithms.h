@@ -2,19 +2,102 @@
 #define GRAPHALGORITHMS_H
 
 #include "Graph.h"
+#include "CompactGraph.h"
+#include "BitMatrix.h"
 #include <limits>
 
+// Single-source shortest path tree. Arrays are indexed by the dense vertex
+// index (idMap[i] is the vertex ID); unreachable vertices keep dist == INF
+// and predEdge == nullptr.
+struct ShortestPathTree {
+    int size;
+    int source;       // dense index of the start vertex, -1 if not found
+    int* idMap;
+    int* dist;
+    int* pred;        // predecessor index, -1 for the source/unreachable
+    Edge** predEdge;  // edge pred[i] -> i
+    HashMap<int, int> indexById;
+
+    explicit ShortestPathTree(int n);
+    ~ShortestPathTree();
+    ShortestPathTree(const ShortestPathTree&) = delete;
+    ShortestPathTree& operator=(const ShortestPathTree&) = delete;
+
+    int indexOf(int id) const;
+    bool reaches(int id) const;
+    LinkedList<Edge*> pathTo(int id) const; // empty if unreachable
+};
+
+class ThreadPool;
+
+// How getAllPairsShortestPaths fills the matrix. Auto picks repeated Dijkstra
+// for sparse graphs and Floyd-Warshall for dense ones (or any negative weight).
+enum class ApspMode {
+    Auto,
+    FloydWarshall,
+    RepeatedDijkstra
+};
+
+// How getPathMatrix computes the transitive closure. Warshall ORs whole
+// bitset rows; Condensed collapses strongly connected components first and
+// closes the (much smaller) DAG. Auto uses Condensed for sparse graphs.
+enum class ClosureMode {
+    Auto,
+    Warshall,
+    Condensed
+};
+
 class GraphAlgorithms {
 public:
-    static bool** getPathMatrix(Graph* graph, int& size);
-    static LinkedList<Edge*> getShortestPathDijkstra(Graph* graph, int startId, int endId);
-    static int** getAllPairsShortestPaths(Graph* graph, int& size, int*& idMap);
+    static constexpr int INF = 1000000000; // "no path" distance
+
+    // Reachability (path of length >= 1) between dense indices, i.e. the
+    // order of Graph::getVertices(). Caller deletes the matrix.
+    static BitMatrix* getPathMatrix(Graph* graph, int& size, ClosureMode mode = ClosureMode::Auto);
+    // Point-to-point: stops as soon as endId is settled. If settledCount is
+    // given it receives the number of vertices taken out of the queue.
+    // These Graph* overloads build a CompactGraph for the one query, an
+    // O(V + E) copy that costs more than a short search; for repeated
+    // queries keep a snapshot and use the overloads below.
+    static LinkedList<Edge*> getShortestPathDijkstra(Graph* graph, int startId, int endId, int* settledCount = nullptr);
+    // Two searches, forward from start and backward from end, meeting halfway
+    static LinkedList<Edge*> getShortestPathBidirectional(Graph* graph, int startId, int endId, int* settledCount = nullptr);
+    // A* guided by the straight-line distance between Vertex x/y coordinates.
+    // The heuristic is scaled by the smallest weight/length ratio of any edge,
+    // so it never overestimates and the result is still exact.
+    static LinkedList<Edge*> getShortestPathAStar(Graph* graph, int startId, int endId, int* settledCount = nullptr);
+    // Single source, all targets. Caller deletes the tree.
+    static ShortestPathTree* getShortestPathTree(Graph* graph, int startId);
+    // Same queries against a prebuilt snapshot, for many queries on one graph.
+    // The bidirectional one needs a snapshot built with reverse edges.
+    static LinkedList<Edge*> getShortestPathDijkstra(const CompactGraph& cg, int startId, int endId, int* settledCount = nullptr);
+    static LinkedList<Edge*> getShortestPathBidirectional(const CompactGraph& cg, int startId, int endId, int* settledCount = nullptr);
+    static LinkedList<Edge*> getShortestPathAStar(const CompactGraph& cg, int startId, int endId, int* settledCount = nullptr);
+    static ShortestPathTree* getShortestPathTree(const CompactGraph& cg, int startId);
+    // Runs on all cores (ThreadPool::global() unless a pool is given)
+    static int** getAllPairsShortestPaths(Graph* graph, int& size, int*& idMap,
+                                          ApspMode mode = ApspMode::Auto, ThreadPool* pool = nullptr);
+    // Minimum spanning forest (one tree per component, edge direction ignored)
     static LinkedList<Edge*> getMSTPrim(Graph* graph);
+    static LinkedList<Edge*> getMSTKruskal(Graph* graph);
     static bool hasCycles(Graph* graph);
-    static double* getClosenessCentrality(Graph* graph, int*& idMap, int& size);
+    // Edges of one cycle in path order (first edge leaves the vertex the last
+    // one enters), empty if the graph is acyclic. In undirected graphs a
+    // cycle needs at least three vertices or a self loop.
+    static LinkedList<Edge*> findCycle(Graph* graph);
+    // Component number for each dense index (idMap gives the IDs), numbered
+    // in reverse topological order: edges only go to equal or lower numbers.
+    // Undirected graphs get their connected components. Caller deletes both.
+    static int* getStronglyConnectedComponents(Graph* graph, int*& idMap, int& size, int& count);
+    // Closeness = reachable vertices / sum of distances to them, one search
+    // per vertex (BFS hop counts on unweighted graphs), in parallel.
+    // With 0 < samples < V it is estimated from that many random pivots;
+    // errorBound then receives e such that, with probability >= 1 - 1/V,
+    // every mean distance is within e * diameter (strongly connected graphs).
+    static double* getClosenessCentrality(Graph* graph, int*& idMap, int& size, int samples = 0,
+                                          double* errorBound = nullptr, ThreadPool* pool = nullptr);
 
     // Helpers
-    static void freeMatrix(bool** matrix, int size);
     static void freeMatrix(int** matrix, int size);
 };
 
@@ -0,0 +1,110 @@
+#ifndef GRAPHLOADER_H
+#define GRAPHLOADER_H
+
+#include "Graph.h"
+#include "GraphTextParser.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+
+class ThreadPool;
+
+// Loads a graph file on a background thread and hands out its vertices and
+// edges while the rest is still being read, so a view can show them right
+// away (see GraphView::startLoading).
+//
+// The Graph is built on the worker. A published vertex or edge never moves
+// and its id, label, position and weight don't change afterwards, so the
+// consumer may read those as soon as it takes them; the adjacency lists
+// belong to the worker until isFinished().
+class GraphLoader : private GraphTextListener {
+public:
+    // With a pool, big text files parse their EDGES section in parallel
+    explicit GraphLoader(const std::string& path, ThreadPool* pool = nullptr);
+    // Cancels and waits for the worker; deletes the graph unless it was taken
+    ~GraphLoader();
+
+    // Cancels and hands the loader over to its worker, which deletes it once
+    // it notices, so the caller doesn't wait for that (see
+    // GraphView::cancelLoading). The loader must not be used afterwards.
+    void discard();
+    // Waits until every discarded loader is gone, before shutdown: their
+    // workers may still be using the thread pool
+    static void waitForDiscarded();
+
+    GraphLoader(const GraphLoader&) = delete;
+    GraphLoader& operator=(const GraphLoader&) = delete;
+
+    void start();
+    // Stops the worker at its next check. The graph is deleted, so nothing
+    // taken so far may be used after calling this.
+    void cancel();
+
+    // Moves up to `max` published items into the arrays. Vertices come
+    // first, and edges only once no vertex is pending, so an edge is never
+    // handed out before both of its endpoints. Undirected twins are handed
+    // out as separate edges.
+    void take(int max, Vertex** vertices, int& vertexCount, Edge** edges, int& edgeCount);
+
+    // Fraction of the file read so far, 0..1
+    double progress() const;
+    // The worker is done and everything it published has been taken
+    bool isFinished();
+    bool wasCanceled() const { return canceled.load(); }
+
+    // After isFinished(): the graph (the caller owns it from now on), or
+    // nullptr if the load failed or was canceled
+    Graph* takeGraph();
+    // After isFinished(): why it failed, or the lines that were skipped
+    const std::string& problems() const { return message; }
+
+private:
+    void run();
+    void publishAll(Graph* loaded);
+    void flush();
+
+    void vertexAdded(Vertex* vertex) override;
+    void edgeAdded(Edge* edge) override;
+    bool progress(size_t done, size_t total) override;
+    bool workerProgress(size_t done, size_t total) override;
+
+    // Growable FIFO of pointers, drained from `head`
+    template <typename T>
+    struct Queue {
+        T* items = nullptr;
+        int head = 0;
+        int count = 0;
+        int capacity = 0;
+        ~Queue() { delete[] items; }
+        void append(T* from, int n);
+        int takeInto(T* out, int max);
+        bool isEmpty() const { return head == count; }
+    };
+
+    static const int kStageSize = 4096;
+
+    std::string path;
+    ThreadPool* pool;
+    std::thread worker;
+
+    // Worker side: filled without locking, moved to the queues by flush()
+    Vertex* stagedVertices[kStageSize];
+    Edge* stagedEdges[kStageSize];
+    int stagedVertexCount;
+    int stagedEdgeCount;
+
+    std::mutex lock; // guards the queues, `graph`, `done` and `discarded`
+    Queue<Vertex*> vertexQueue;
+    Queue<Edge*> edgeQueue;
+    Graph* graph;
+    bool done;
+    bool discarded; // the worker deletes the loader when it finishes
+    std::string message; // written by the worker before `done`
+
+    std::atomic<bool> canceled;
+    std::atomic<size_t> bytesDone;
+    std::atomic<size_t> bytesTotal;
+};
+
+#endif // GRAPHLOADER_H
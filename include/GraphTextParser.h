@@ -0,0 +1,96 @@
+#ifndef GRAPHTEXTPARSER_H
+#define GRAPHTEXTPARSER_H
+
+#include "Graph.h"
+#include "LinkedList.h"
+#include <cstddef>
+#include <string>
+
+class ThreadPool;
+
+// A line the parser skipped, with its 1-based line number
+struct TextParseError {
+    int line;
+    std::string message;
+};
+
+// Observer for GraphTextParser::parse, called on the thread that parses.
+// Lets a caller use vertices and edges while the rest of the file is read.
+class GraphTextListener {
+public:
+    virtual ~GraphTextListener() {}
+    virtual void vertexAdded(Vertex* vertex) = 0;
+    // The new edge; on undirected graphs its twin was added with it
+    virtual void edgeAdded(Edge* edge) = 0;
+    // Called every few thousand lines; returning false stops the parse and
+    // parse() returns what was read so far
+    virtual bool progress(size_t bytesDone, size_t bytesTotal) = 0;
+    // Same, but from the pool's workers while a parallel parse reads its
+    // slices: may run on several threads at once, and nothing is added to
+    // the graph meanwhile. Returning false stops the parse before any of the
+    // section's edges are added.
+    virtual bool workerProgress(size_t bytesDone, size_t bytesTotal) {
+        (void)bytesDone;
+        (void)bytesTotal;
+        return true;
+    }
+};
+
+// Streaming parser for the text format written by FileController:
+//
+//   TYPE:DIRECTED | TYPE:UNDIRECTED
+//   WEIGHTED:TRUE | WEIGHTED:FALSE
+//   NODES
+//   id,label,x,y
+//   EDGES
+//   src,dest,weight
+//
+// Works on one buffer (normally a mapped file): lines are found with memchr,
+// numbers are read in place with std::from_chars, and no std::string is built
+// except the label a vertex keeps. Malformed lines are skipped and reported
+// instead of throwing. Accepts \r\n line ends, blank lines, spaces around
+// numbers, and commas inside labels (x and y are the last two fields).
+class GraphTextParser {
+public:
+    GraphTextParser(const char* data, size_t size);
+
+    void setListener(GraphTextListener* observer) { listener = observer; }
+    // True if the listener stopped the last parse
+    bool wasStopped() const { return stopped; }
+
+    // Builds a new Graph (caller deletes) from the whole buffer. With a pool,
+    // the EDGES section (once NODES is loaded) is cut into slices at line
+    // breaks, each slice is parsed and its endpoints looked up on a worker
+    // into its own buffer, and the buffers are added to the graph in file
+    // order afterwards. The result and the error report are the same as the
+    // single-threaded parse.
+    Graph* parse(ThreadPool* pool = nullptr);
+
+    // Everything that was skipped. Only the first kMaxStoredErrors are kept,
+    // errorCount() has the total.
+    static const int kMaxStoredErrors = 100;
+    int errorCount() const { return totalErrors; }
+    LinkedList<TextParseError>& errors() { return errorList; }
+    // "line N: message" lines, for showing to the user
+    std::string errorSummary();
+
+    // Single-line parsers over [begin, end) without the line break. They
+    // return nullptr on success or a description of the problem.
+    static const char* parseEdgeLine(const char* begin, const char* end, int& src, int& dest, int& weight);
+    static const char* parseNodeLine(const char* begin, const char* end, int& id,
+                                     const char*& label, size_t& labelLength, int& x, int& y);
+
+private:
+    void report(int line, const std::string& message);
+    void addEdge(Graph* graph, int line, int src, int dest, int weight);
+    bool parseEdgesParallel(Graph* graph, const char* begin, const char* end, int linesBefore, ThreadPool* pool);
+
+    const char* data;
+    size_t size;
+    LinkedList<TextParseError> errorList;
+    int totalErrors;
+    GraphTextListener* listener;
+    bool stopped;
+};
+
+#endif // GRAPHTEXTPARSER_H
@@ -4,8 +4,15 @@
 #include <QGraphicsView>
 #include <QGraphicsScene>
 #include "Graph.h"
+#include "CompactGraph.h"
 #include "VisualItems.h"
+#include "EdgeLayer.h"
 #include "LinkedList.h" // For highlight path
+#include "HashMap.h"
+#include <QElapsedTimer>
+
+class GraphLoader;
+class QTimer;
 
 class GraphView : public QGraphicsView {
     Q_OBJECT
@@ -16,6 +23,13 @@ signals:
     void requestAddNode(int id, QString label, qreal x, qreal y);
     void requestAddEdge(int srcId, int destId, int weight);
     void requestDeleteVertex(int id);
+    void requestDeleteEdge(int srcId, int destId);
+    void loadProgress(int percent);
+    void loadFinished(bool ok, QString problems);
+    void loadCanceled();
+    // Painted frames per second and average paint time, about twice a second
+    // while the view repaints
+    void frameStats(double fps, double paintMs);
 
 public:
     enum class Mode {
@@ -31,9 +45,38 @@ public:
     void setInteractionMode(Mode mode);
     Graph* getGraph();
     void setGraph(Graph* newGraph);
+    // CSR snapshot of the graph for the shortest path queries. Built on first
+    // use (O(V + E)) and kept until the graph changes (graphChanged, a layout
+    // pass), so repeated queries on an unchanged graph skip the copy.
+    const CompactGraph& snapshot(bool withReverse = false);
+
+    // Edits for the undo commands: each one changes the graph and only the
+    // scene items it touches, O(degree) instead of a setGraph rebuild
+    Vertex* addNode(int id, const std::string& label, int x, int y);
+    bool removeNode(int id);
+    bool moveNode(int id, int x, int y);
+    Edge* addEdge(int srcId, int destId, int weight);
+    bool removeEdge(int srcId, int destId);
+
+    // Loads the file on a background thread (GraphLoader). Nodes and edges
+    // are added to the scene in small batches as they are read, so the view
+    // stays responsive; the current graph is kept until the load succeeds
+    // and comes back if it fails or is canceled. Reports through
+    // loadProgress, then loadFinished or loadCanceled.
+    void startLoading(const QString& fileName);
+    void cancelLoading();
+    bool isLoading() const { return loader != nullptr; }
     
     void clear();
     void highlightPath(LinkedList<Edge*>& path);
+
+    // Batched mode draws every edge through one EdgeLayer instead of a
+    // VisualEdge each, for graphs with too many edges for per-item
+    // painting. Switching rebuilds the scene.
+    void setBatchedEdges(bool on);
+    bool batchedEdges() const { return batched; }
+    // Edge drawn under a scene point, within a few pixels, or nullptr
+    Edge* edgeAt(const QPointF& scenePos);
     void exportToImage(const QString& fileName);
     void exportToSVG(const QString& fileName);
     void applyForceLayout();
@@ -51,6 +94,7 @@ protected:
     void mouseReleaseEvent(QMouseEvent *event) override;
     void wheelEvent(QWheelEvent *event) override;
     void drawBackground(QPainter *painter, const QRectF &rect) override;
+    void paintEvent(QPaintEvent *event) override;
 
 private:
     QGraphicsScene* scene;
@@ -61,15 +105,48 @@ private:
     VisualNode* tempSourceNode; // For creating edge
     
     // Mappings
-    // We need to map Vertex* to VisualNode* for algorithms highlighting
-    // Since we can't use std::map, we can search scene items or add lookup to Vertex? 
-    // Adding `void* visualPtr` to Vertex is a hack but effective. 
-    // Or just iterate scene items.
+    // Every item in the scene is registered here when it is created, so
+    // finding the item of a vertex or edge (scene construction, highlighting)
+    // is O(1) instead of a scan of scene->items().
+    HashMap<Vertex*, VisualNode*> nodeItems;
+    HashMap<Edge*, VisualEdge*> edgeItems;
     VisualNode* getVisualForVertex(Vertex* v);
     VisualEdge* getVisualForEdge(Edge* e);
+    VisualNode* createNodeItem(Vertex* v);
+    void createEdgeItem(Edge* e);
+    void deleteEdgeItem(Edge* e);
+    void clearScene(); // scene->clear() plus the mappings
+
+    // Batched mode: the layer and each edge's slot in it. An undirected
+    // edge and its twin share one slot.
+    bool batched;
+    EdgeLayer* edgeLayer;
+    HashMap<Edge*, int> edgeSlots;
+
+    CompactGraph* compact; // snapshot(), nullptr when stale
+    void dropSnapshot();
 
     bool isPanning;
     QPoint lastPanPos;
+
+    // Edge updates from node moves. While a drag (or a layout pass) moves
+    // many nodes, each edge is queued once and repositioned at the end.
+    bool coalesceMoves;
+    VisualEdgeList pendingEdges;
+    void flushEdgeUpdates();
+    void moveLayerEdge(Edge* e);
+
+    // Paint timing for frameStats
+    QElapsedTimer statsClock;
+    int framesPainted;
+    qint64 paintNanos;
+
+    // Streaming load
+    void addLoadedItems();
+    void finishLoading();
+    GraphLoader* loader;
+    QTimer* loadTimer;
+    int nextIdBeforeLoad;
 };
 
 #endif // GRAPHVIEW_H
@@ -0,0 +1,192 @@
+#ifndef HASHMAP_H
+#define HASHMAP_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Hashing for HashMap keys. Integers and pointers go through a 64-bit
+// finalizer (splitmix64) so that sequential IDs and pointers returned by the
+// allocator don't pile up into long runs under linear probing.
+inline size_t hashMix(uint64_t x) {
+    x ^= x >> 30;
+    x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27;
+    x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return (size_t)x;
+}
+
+template <typename K>
+struct HashKey {
+    static size_t hash(const K& key) { return hashMix((uint64_t)key); }
+};
+
+template <typename T>
+struct HashKey<T*> {
+    static size_t hash(T* key) { return hashMix((uint64_t)(uintptr_t)key); }
+};
+
+// Open-addressing hash table (linear probing, power-of-two capacity).
+// Removal uses backward-shift deletion, so there are no tombstones and probe
+// sequences stay short no matter how many inserts/removes happen.
+template <typename K, typename V>
+class HashMap {
+public:
+    HashMap() : keys(nullptr), values(nullptr), used(nullptr), capacity(0), count(0) {}
+
+    ~HashMap() {
+        release();
+    }
+
+    // Same policy as LinkedList: no implicit copies of big tables
+    HashMap(const HashMap&) = delete;
+    HashMap& operator=(const HashMap&) = delete;
+
+    // Returns false (and leaves the table untouched) if the key already exists
+    bool insert(const K& key, const V& value) {
+        if ((count + 1) * 10 > capacity * 7) grow();
+        size_t i = slotFor(key);
+        if (used[i]) return false;
+        used[i] = true;
+        keys[i] = key;
+        values[i] = value;
+        count++;
+        return true;
+    }
+
+    // Insert or overwrite
+    void put(const K& key, const V& value) {
+        if ((count + 1) * 10 > capacity * 7) grow();
+        size_t i = slotFor(key);
+        if (!used[i]) {
+            used[i] = true;
+            keys[i] = key;
+            count++;
+        }
+        values[i] = value;
+    }
+
+    V* find(const K& key) {
+        if (count == 0) return nullptr;
+        size_t i = slotFor(key);
+        return used[i] ? &values[i] : nullptr;
+    }
+
+    const V* find(const K& key) const {
+        if (count == 0) return nullptr;
+        size_t i = slotFor(key);
+        return used[i] ? &values[i] : nullptr;
+    }
+
+    bool contains(const K& key) const {
+        return find(key) != nullptr;
+    }
+
+    bool remove(const K& key) {
+        if (count == 0) return false;
+        size_t i = slotFor(key);
+        if (!used[i]) return false;
+
+        // Backward-shift: pull later entries of the same cluster into the
+        // hole if their home slot allows it.
+        size_t mask = capacity - 1;
+        size_t hole = i;
+        size_t j = i;
+        while (true) {
+            j = (j + 1) & mask;
+            if (!used[j]) break;
+            size_t home = HashKey<K>::hash(keys[j]) & mask;
+            // Can entry j move to hole? Only if home is not in (hole, j]
+            bool between = (hole <= j) ? (home > hole && home <= j)
+                                       : (home > hole || home <= j);
+            if (!between) {
+                keys[hole] = keys[j];
+                values[hole] = values[j];
+                hole = j;
+            }
+        }
+        used[hole] = false;
+        count--;
+        return true;
+    }
+
+    // Pre-size the table for `n` entries to avoid rehashing during bulk loads
+    void reserve(size_t n) {
+        size_t needed = 16;
+        while (needed * 7 < n * 10) needed <<= 1;
+        if (needed > capacity) rehash(needed);
+    }
+
+    void clear() {
+        for (size_t i = 0; i < capacity; ++i) used[i] = false;
+        count = 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    bool isEmpty() const {
+        return count == 0;
+    }
+
+private:
+    // Slot holding `key`, or the empty slot where it would be inserted
+    size_t slotFor(const K& key) const {
+        size_t mask = capacity - 1;
+        size_t i = HashKey<K>::hash(key) & mask;
+        while (used[i] && !(keys[i] == key)) {
+            i = (i + 1) & mask;
+        }
+        return i;
+    }
+
+    void grow() {
+        rehash(capacity == 0 ? 16 : capacity * 2);
+    }
+
+    void rehash(size_t newCapacity) {
+        K* oldKeys = keys;
+        V* oldValues = values;
+        bool* oldUsed = used;
+        size_t oldCapacity = capacity;
+
+        keys = new K[newCapacity];
+        values = new V[newCapacity];
+        used = new bool[newCapacity];
+        for (size_t i = 0; i < newCapacity; ++i) used[i] = false;
+        capacity = newCapacity;
+
+        for (size_t i = 0; i < oldCapacity; ++i) {
+            if (oldUsed[i]) {
+                size_t slot = slotFor(oldKeys[i]);
+                used[slot] = true;
+                keys[slot] = oldKeys[i];
+                values[slot] = oldValues[i];
+            }
+        }
+
+        delete[] oldKeys;
+        delete[] oldValues;
+        delete[] oldUsed;
+    }
+
+    void release() {
+        delete[] keys;
+        delete[] values;
+        delete[] used;
+        keys = nullptr;
+        values = nullptr;
+        used = nullptr;
+        capacity = 0;
+        count = 0;
+    }
+
+    K* keys;
+    V* values;
+    bool* used;
+    size_t capacity;
+    size_t count;
+};
+
+#endif // HASHMAP_H
@@ -0,0 +1,120 @@
+#ifndef INDEXEDMINHEAP_H
+#define INDEXEDMINHEAP_H
+
+// Binary min-heap over the keys 0..capacity-1 with a position table, so a
+// key's priority can be lowered in O(log n) (decrease-key) instead of pushing
+// duplicates. Used by Dijkstra, Prim and friends with dense vertex indices.
+template <typename P>
+class IndexedMinHeap {
+public:
+    explicit IndexedMinHeap(int capacity) : count(0), capacity(capacity) {
+        heap = new int[capacity > 0 ? capacity : 1];
+        pos = new int[capacity > 0 ? capacity : 1];
+        prio = new P[capacity > 0 ? capacity : 1];
+        for (int i = 0; i < capacity; ++i) pos[i] = -1;
+    }
+
+    ~IndexedMinHeap() {
+        delete[] heap;
+        delete[] pos;
+        delete[] prio;
+    }
+
+    IndexedMinHeap(const IndexedMinHeap&) = delete;
+    IndexedMinHeap& operator=(const IndexedMinHeap&) = delete;
+
+    bool isEmpty() const { return count == 0; }
+    int size() const { return count; }
+    int getCapacity() const { return capacity; }
+    bool contains(int key) const { return pos[key] != -1; }
+    P priorityOf(int key) const { return prio[key]; }
+
+    void push(int key, P priority) {
+        prio[key] = priority;
+        heap[count] = key;
+        pos[key] = count;
+        siftUp(count++);
+    }
+
+    // Lower the priority of a key already in the heap. Ignored if not lower.
+    void decreaseKey(int key, P priority) {
+        if (!(priority < prio[key])) return;
+        prio[key] = priority;
+        siftUp(pos[key]);
+    }
+
+    // Insert the key, or lower its priority if it is already queued.
+    // Returns true if the heap changed.
+    bool pushOrDecrease(int key, P priority) {
+        if (pos[key] == -1) {
+            push(key, priority);
+            return true;
+        }
+        if (priority < prio[key]) {
+            decreaseKey(key, priority);
+            return true;
+        }
+        return false;
+    }
+
+    int top() const { return heap[0]; }
+    P topPriority() const { return prio[heap[0]]; }
+
+    int pop() {
+        int key = heap[0];
+        pos[key] = -1;
+        count--;
+        if (count > 0) {
+            heap[0] = heap[count];
+            pos[heap[0]] = 0;
+            siftDown(0);
+        }
+        return key;
+    }
+
+    // O(size): only the queued keys are reset, so reusing one heap across
+    // many searches doesn't cost O(capacity) each time
+    void clear() {
+        for (int i = 0; i < count; ++i) pos[heap[i]] = -1;
+        count = 0;
+    }
+
+private:
+    void siftUp(int i) {
+        int key = heap[i];
+        P p = prio[key];
+        while (i > 0) {
+            int parent = (i - 1) / 2;
+            if (!(p < prio[heap[parent]])) break;
+            heap[i] = heap[parent];
+            pos[heap[i]] = i;
+            i = parent;
+        }
+        heap[i] = key;
+        pos[key] = i;
+    }
+
+    void siftDown(int i) {
+        int key = heap[i];
+        P p = prio[key];
+        while (true) {
+            int child = 2 * i + 1;
+            if (child >= count) break;
+            if (child + 1 < count && prio[heap[child + 1]] < prio[heap[child]]) child++;
+            if (!(prio[heap[child]] < p)) break;
+            heap[i] = heap[child];
+            pos[heap[i]] = i;
+            i = child;
+        }
+        heap[i] = key;
+        pos[key] = i;
+    }
+
+    int* heap;  // heap slot -> key
+    int* pos;   // key -> heap slot, -1 when not queued
+    P* prio;    // key -> priority
+    int count;
+    int capacity;
+};
+
+#endif // INDEXEDMINHEAP_H
@@ -6,6 +6,8 @@
 #include <QAction>
 #include <QComboBox>
 #include <QLabel>
+#include <QProgressBar>
+#include <QPushButton>
 #include "GraphView.h"
 #include "Graph.h"
 #include "Command.h"
@@ -47,13 +49,18 @@ private slots:
     void handleRequestAddNode(int id, QString label, qreal x, qreal y);
     void handleRequestAddEdge(int srcId, int destId, int weight);
     void handleRequestDeleteVertex(int id);
+    void handleRequestDeleteEdge(int srcId, int destId);
     
     void updateStats();
+    void handleLoadFinished(bool ok, QString problems);
+    void handleLoadCanceled();
+    void handleFrameStats(double fps, double paintMs);
 
 private:
     void createActions();
     void createToolBar();
     void applyStyle();
+    void setEditingEnabled(bool enabled);
 
     GraphView* graphView;
     QLabel* statsLabel;
@@ -68,6 +75,7 @@ private:
     QAction* actionMove;
     QAction* actionDelete;
     QAction* actionForceLayout;
+    QAction* actionBatchedEdges;
     
     QAction* actionPathMatrix;
     QAction* actionDijkstra;
@@ -83,6 +91,10 @@ private:
     LinkedList<Command*> redoStack;
 
     QLabel* statusLabel;
+    QLabel* frameStatsLabel;
+    QProgressBar* loadProgressBar;
+    QPushButton* cancelLoadButton;
+    QString loadingFileName;
 };
 
 #endif // MAINWINDOW_H
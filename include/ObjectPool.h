@@ -0,0 +1,107 @@
+#ifndef OBJECTPOOL_H
+#define OBJECTPOOL_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+
+// Slab allocator for objects of one type. Storage comes from slabs that grow
+// geometrically (64 objects up to 64k per slab), so a million edges cost a
+// few dozen heap allocations instead of a million, and they sit next to each
+// other in memory. Single objects can be returned to a free list and reused;
+// releaseAll() drops every slab at once without running destructors, which
+// is how Graph::clear frees a whole graph. Not thread-safe.
+template <typename T>
+class ObjectPool {
+public:
+    ObjectPool() : slabs(nullptr), slabCount(0), slabCapacity(0),
+                   cursor(nullptr), limit(nullptr), freeList(nullptr), nextSlabSize(kFirstSlab), live(0) {}
+
+    ~ObjectPool() {
+        releaseAll();
+        delete[] slabs;
+    }
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template <typename... Args>
+    T* create(Args&&... args) {
+        return new (allocate()) T(std::forward<Args>(args)...);
+    }
+
+    void destroy(T* object) {
+        if (!object) return;
+        object->~T();
+        deallocate(object);
+    }
+
+    // Raw storage for one T
+    void* allocate() {
+        live++;
+        if (freeList) {
+            Slot* slot = freeList;
+            freeList = slot->next;
+            return slot->storage;
+        }
+        if (cursor == limit) addSlab();
+        return (cursor++)->storage;
+    }
+
+    void deallocate(void* p) {
+        Slot* slot = static_cast<Slot*>(p);
+        slot->next = freeList;
+        freeList = slot;
+        live--;
+    }
+
+    // Frees every slab. Objects still alive are NOT destroyed: the caller
+    // must have run any destructor that matters (or T must not need one).
+    void releaseAll() {
+        for (size_t i = 0; i < slabCount; ++i) delete[] slabs[i];
+        slabCount = 0;
+        cursor = limit = nullptr;
+        freeList = nullptr;
+        nextSlabSize = kFirstSlab;
+        live = 0;
+    }
+
+    size_t liveCount() const { return live; }
+    size_t slabsInUse() const { return slabCount; }
+
+private:
+    union Slot {
+        Slot* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static constexpr size_t kFirstSlab = 64;
+    static constexpr size_t kMaxSlab = 65536;
+
+    void addSlab() {
+        if (slabCount == slabCapacity) {
+            size_t newCapacity = slabCapacity == 0 ? 16 : slabCapacity * 2;
+            Slot** grown = new Slot*[newCapacity];
+            for (size_t i = 0; i < slabCount; ++i) grown[i] = slabs[i];
+            delete[] slabs;
+            slabs = grown;
+            slabCapacity = newCapacity;
+        }
+        Slot* slab = new Slot[nextSlabSize];
+        slabs[slabCount++] = slab;
+        cursor = slab;
+        limit = slab + nextSlabSize;
+        if (nextSlabSize < kMaxSlab) nextSlabSize *= 2;
+    }
+
+    Slot** slabs;
+    size_t slabCount;
+    size_t slabCapacity;
+    Slot* cursor;   // bump pointer inside the newest slab
+    Slot* limit;
+    Slot* freeList; // objects handed back with deallocate()
+    size_t nextSlabSize;
+    size_t live;
+};
+
+#endif // OBJECTPOOL_H
@@ -0,0 +1,118 @@
+#ifndef SEGMENTINDEX_H
+#define SEGMENTINDEX_H
+
+#include "HashMap.h"
+#include <algorithm>
+#include <cstdint>
+
+// Spatial index of line segments for the batched edge layer (EdgeLayer):
+// which segments cross the visible rect, and which one is under the mouse.
+//
+// A hierarchical grid: level L has square cells of cellSize * 2^L, and a
+// segment is filed under the one cell, at the smallest level whose cells are
+// at least as big as its bounding box, that holds the box's center. Short
+// and long edges both take a single entry, and a box can only stick out of
+// its cell by half a cell, so a query checks each level's cells around the
+// rect widened by that much. Coordinates are packed as x1, y1, x2, y2.
+class SegmentIndex {
+public:
+    explicit SegmentIndex(float cellSize = 64.0f);
+    ~SegmentIndex();
+
+    SegmentIndex(const SegmentIndex&) = delete;
+    SegmentIndex& operator=(const SegmentIndex&) = delete;
+
+    // Returns the segment's id; ids of removed segments are reused
+    int add(float x1, float y1, float x2, float y2);
+    void move(int id, float x1, float y1, float x2, float y2);
+    void remove(int id);
+    void clear();
+
+    int size() const { return live; }
+    int slotCount() const { return idCount; } // every id is below this
+    bool isLive(int id) const { return cellOf[id] != kFree; }
+    const float* segment(int id) const { return coords + 4 * id; }
+
+    // Closest segment to (x, y) no farther than `tolerance`, or -1
+    int nearest(float x, float y, float tolerance) const;
+
+    // Calls visit(id) once for every segment whose bounding box meets the
+    // rect. When the cells to check would hold about half the segments or
+    // more (a view of most of the graph, or long edges crossing it, which
+    // sit in a few big cells), or there are more cells than segments, a
+    // straight pass over the coordinates is faster than walking the cells.
+    template <typename F>
+    void query(float left, float top, float right, float bottom, F visit) const {
+        if (live == 0) return;
+        CellRange ranges[kLevels];
+        uint64_t probes = 0;
+        double candidates = 0; // assuming each level is evenly spread over its cells
+        for (int level = 0; level < kLevels; ++level) {
+            ranges[level] = cellsAround(level, left, top, right, bottom);
+            uint64_t cells = ranges[level].count();
+            probes += cells;
+            if (cells) candidates += (double)levelSize[level] * cells / used[level].count();
+        }
+        if (probes > (uint64_t)live || candidates * 2 > live) {
+            for (int id = 0; id < idCount; ++id) {
+                if (overlaps(id, left, top, right, bottom)) visit(id); // false for removed ids
+            }
+            return;
+        }
+        for (int level = 0; level < kLevels; ++level) {
+            const CellRange& r = ranges[level];
+            for (int cy = r.y0; cy <= r.y1; ++cy) {
+                for (int cx = r.x0; cx <= r.x1; ++cx) {
+                    const int* head = heads.find(cellKey(level, cx, cy));
+                    if (!head) continue;
+                    for (int id = *head; id != -1; id = next[id]) {
+                        if (overlaps(id, left, top, right, bottom)) visit(id);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    static const int kLevels = 24;
+    static const uint64_t kFree = ~(uint64_t)0;
+
+    // Inclusive cell coordinates; empty when x0 > x1 or y0 > y1
+    struct CellRange {
+        int x0, y0, x1, y1;
+        uint64_t count() const {
+            return (x0 > x1 || y0 > y1) ? 0 : (uint64_t)(x1 - x0 + 1) * (uint64_t)(y1 - y0 + 1);
+        }
+    };
+
+    static uint64_t cellKey(int level, int cx, int cy);
+    uint64_t keyFor(const float* s, int& level) const;
+    CellRange cellsAround(int level, float left, float top, float right, float bottom) const;
+    // Inline: query() calls it once per segment on the straight pass
+    bool overlaps(int id, float left, float top, float right, float bottom) const {
+        const float* s = segment(id);
+        return std::min(s[0], s[2]) <= right && std::max(s[0], s[2]) >= left && std::min(s[1], s[3]) <= bottom &&
+               std::max(s[1], s[3]) >= top;
+    }
+    void link(int id, uint64_t key, int level);
+    void unlink(int id);
+    void grow();
+
+    float cellSize;
+    float* coords; // NaN for removed ids, which then overlap nothing
+    int* next; // next segment in the same cell, or in the free list
+    int* prev;
+    uint64_t* cellOf; // kFree for unused ids
+    int idCount;
+    int capacity;
+    int live;
+    int freeHead;
+    HashMap<uint64_t, int> heads; // cell -> first segment
+
+    // Cells each level has used since the last clear(), so a query never
+    // probes beyond them
+    int levelSize[kLevels];
+    CellRange used[kLevels];
+};
+
+#endif // SEGMENTINDEX_H
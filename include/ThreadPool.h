@@ -0,0 +1,87 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+// Fixed set of worker threads running parallel loops with work stealing.
+// parallelFor hands each worker an equal slice of the index range; a worker
+// splits its slice lazily (keeps the lower half, pushes the upper half on its
+// own deque) and, when it runs dry, steals the oldest (largest) range from
+// another worker. The calling thread takes part as worker 0.
+//
+// One loop runs at a time; calling parallelFor from inside a loop body is not
+// supported (it would wait on itself).
+class ThreadPool {
+public:
+    // size <= 0 uses std::thread::hardware_concurrency()
+    explicit ThreadPool(int size = 0);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    // Process-wide pool sized to the machine
+    static ThreadPool& global();
+
+    // Workers including the caller; size per-worker scratch buffers with this
+    int threadCount() const { return workerCount; }
+
+    // body(i, worker) for every i in [begin, end). Ranges smaller than
+    // `grain` are not split further.
+    template <typename F>
+    void parallelFor(int begin, int end, int grain, F&& body) {
+        typedef typename std::remove_reference<F>::type Body;
+        run(begin, end, grain, [](void* ctx, int lo, int hi, int worker) {
+            Body& f = *static_cast<Body*>(ctx);
+            for (int i = lo; i < hi; ++i) f(i, worker);
+        }, (void*)&body);
+    }
+
+private:
+    typedef void (*RangeFn)(void* ctx, int lo, int hi, int worker);
+
+    struct Range {
+        int lo, hi;
+    };
+
+    // Owner pushes/pops at the tail, thieves take from the head. Lazy binary
+    // splitting keeps at most ~32 ranges per worker.
+    struct WorkQueue {
+        static const int kCapacity = 64;
+        std::mutex lock;
+        Range items[kCapacity];
+        int head = 0;
+        int tail = 0;
+    };
+
+    void run(int begin, int end, int grain, RangeFn fn, void* ctx);
+    void workerMain(int id);
+    void work(int id);
+    void pushLocal(int id, Range r);
+    bool popLocal(int id, Range& r);
+    bool steal(int id, Range& r);
+
+    int workerCount;
+    std::thread* threads;   // workerCount - 1 background threads
+    WorkQueue* queues;      // one per worker
+
+    // Current loop
+    RangeFn jobFn;
+    void* jobCtx;
+    int jobGrain;
+    std::atomic<long long> pending; // iterations not finished yet
+
+    std::mutex runLock;     // serializes parallelFor callers
+    std::mutex stateLock;
+    std::condition_variable startCv;
+    std::condition_variable doneCv;
+    unsigned long long generation;
+    int activeWorkers;      // background workers inside work()
+    bool stopping;
+};
+
+#endif // THREADPOOL_H
@@ -0,0 +1,61 @@
+#ifndef UNIONFIND_H
+#define UNIONFIND_H
+
+// Disjoint sets over the keys 0..n-1 with union by rank and path compression
+// (path halving), so any sequence of operations is effectively O(1) each.
+// Used by Kruskal with dense vertex indices.
+class UnionFind {
+public:
+    explicit UnionFind(int n) : count(n), sets(n) {
+        parent = new int[n > 0 ? n : 1];
+        rank = new unsigned char[n > 0 ? n : 1];
+        for (int i = 0; i < n; ++i) {
+            parent[i] = i;
+            rank[i] = 0;
+        }
+    }
+
+    ~UnionFind() {
+        delete[] parent;
+        delete[] rank;
+    }
+
+    UnionFind(const UnionFind&) = delete;
+    UnionFind& operator=(const UnionFind&) = delete;
+
+    int find(int x) {
+        while (parent[x] != x) {
+            parent[x] = parent[parent[x]];
+            x = parent[x];
+        }
+        return x;
+    }
+
+    // Returns false if a and b were already in the same set
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) return false;
+        if (rank[a] < rank[b]) {
+            int t = a;
+            a = b;
+            b = t;
+        }
+        parent[b] = a;
+        if (rank[a] == rank[b]) rank[a]++;
+        sets--;
+        return true;
+    }
+
+    bool connected(int a, int b) { return find(a) == find(b); }
+    int size() const { return count; }
+    int setCount() const { return sets; }
+
+private:
+    int* parent;
+    unsigned char* rank; // <= log2(n), fits easily
+    int count;
+    int sets;
+};
+
+#endif // UNIONFIND_H
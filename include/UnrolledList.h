@@ -0,0 +1,235 @@
+#ifndef UNROLLEDLIST_H
+#define UNROLLEDLIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include "ObjectPool.h"
+
+// Chunk of an UnrolledList: up to N elements plus a bitmask of the occupied
+// slots. Elements never move once stored, so a (chunk, slot) pair stays a
+// valid handle until that element is removed.
+template <typename T, int N>
+struct UnrolledChunk {
+    T items[N];
+    uint64_t occupied; // bit i set = items[i] holds an element
+    int fill;          // slots [0, fill) have been handed out
+    UnrolledChunk* next;
+    UnrolledChunk* prev;
+
+    UnrolledChunk() : occupied(0), fill(0), next(nullptr), prev(nullptr) {}
+};
+
+// Same interface as LinkedList (push_back, remove, front/back, range-for),
+// stored as a doubly linked list of chunks of N elements. One allocation per
+// N elements and iteration walks contiguous slots. Each chunk carries 32
+// bytes of bookkeeping (mask, fill, next, prev) on top of its N slots: for
+// pointers that is 4 bytes per element in a full 8-slot chunk against a
+// 24-byte LinkedList node, but a short list pays for a whole chunk, so a
+// vertex with one edge holds two 96-byte chunks (edges and incoming).
+// remove() leaves a hole instead of shifting later elements (order and
+// handles are preserved); a chunk is freed once it is empty, and pop_back
+// reuses the tail slots.
+// Do not erase/remove from a list while iterating over it: emptying the
+// chunk the iterator is on frees it, and the next ++ reads its `next`
+// pointer (a later slot of the same chunk is still visited, since the
+// iterator keeps its own copy of the mask). Graph::removeVertex walks one
+// list and erases from the others.
+template <typename T, int N = 16>
+class UnrolledList {
+    static_assert(N > 0 && N <= 64, "chunk occupancy is a 64-bit mask");
+
+public:
+    typedef UnrolledChunk<T, N> Chunk;
+
+    UnrolledList() : head(nullptr), tail(nullptr), count(0), pool(nullptr) {}
+
+    // Chunks come from `chunkPool` instead of the heap (see Graph)
+    explicit UnrolledList(ObjectPool<Chunk>* chunkPool) : head(nullptr), tail(nullptr), count(0), pool(chunkPool) {}
+
+    // The copy is compact and always uses the heap
+    UnrolledList(const UnrolledList& other) : head(nullptr), tail(nullptr), count(0), pool(nullptr) {
+        for (const T& value : other) push_back(value);
+    }
+
+    UnrolledList& operator=(const UnrolledList&) = delete;
+
+    ~UnrolledList() {
+        clear();
+    }
+
+    // Handle of the element that was just stored: the chunk and its slot
+    struct Position {
+        Chunk* chunk;
+        int slot;
+    };
+
+    Position push_back(const T& value) {
+        if (!tail || tail->fill == N) appendChunk();
+        int slot = tail->fill++;
+        tail->items[slot] = value;
+        tail->occupied |= (uint64_t)1 << slot;
+        count++;
+        return Position{tail, slot};
+    }
+
+    T& front() { return head->items[lowestSlot(head)]; }
+    const T& front() const { return head->items[lowestSlot(head)]; }
+    T& back() { return tail->items[highestSlot(tail)]; }
+    const T& back() const { return tail->items[highestSlot(tail)]; }
+
+    void pop_back() {
+        if (!tail) return;
+        int slot = highestSlot(tail);
+        tail->occupied &= ~((uint64_t)1 << slot);
+        tail->fill = slot; // nothing live above it, so these slots are free again
+        count--;
+        if (tail->occupied == 0) unlink(tail);
+    }
+
+    bool remove(const T& value) {
+        for (Chunk* c = head; c; c = c->next) {
+            uint64_t bits = c->occupied;
+            while (bits) {
+                int slot = lowestBit(bits);
+                bits &= bits - 1;
+                if (c->items[slot] == value) {
+                    erase(Position{c, slot});
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+    // O(1) removal through a handle returned by push_back
+    void erase(Position pos) {
+        Chunk* c = pos.chunk;
+        c->occupied &= ~((uint64_t)1 << pos.slot);
+        count--;
+        if (c->occupied == 0) unlink(c);
+        else if (c == tail && pos.slot == c->fill - 1) c->fill = highestSlot(c) + 1;
+    }
+
+    void clear() {
+        Chunk* c = head;
+        while (c) {
+            Chunk* next = c->next;
+            freeChunk(c);
+            c = next;
+        }
+        head = tail = nullptr;
+        count = 0;
+    }
+
+    // Empties the list without freeing the chunks. Only for when their pool
+    // is about to be released as a whole (Graph::clear).
+    void forgetNodes() {
+        head = tail = nullptr;
+        count = 0;
+    }
+
+    size_t size() const {
+        return count;
+    }
+
+    bool isEmpty() const {
+        return count == 0;
+    }
+
+    // Iterator support: walks the set bits of each chunk
+    template <typename Ref, typename ChunkPtr>
+    class basic_iterator {
+        ChunkPtr chunk;
+        uint64_t remaining; // occupied slots of `chunk` not visited yet
+        int slot;
+
+        void settle() {
+            while (chunk && remaining == 0) {
+                chunk = chunk->next;
+                remaining = chunk ? chunk->occupied : 0;
+            }
+            if (chunk) slot = lowestBit(remaining);
+        }
+
+    public:
+        basic_iterator(ChunkPtr start) : chunk(start), remaining(start ? start->occupied : 0), slot(0) {
+            settle();
+        }
+
+        Ref operator*() const { return chunk->items[slot]; }
+        basic_iterator& operator++() {
+            remaining &= remaining - 1;
+            settle();
+            return *this;
+        }
+        bool operator!=(const basic_iterator& other) const {
+            return chunk != other.chunk || (chunk && slot != other.slot);
+        }
+        bool operator==(const basic_iterator& other) const {
+            return !(*this != other);
+        }
+    };
+
+    typedef basic_iterator<T&, Chunk*> iterator;
+    typedef basic_iterator<const T&, const Chunk*> const_iterator;
+
+    iterator begin() { return iterator(head); }
+    iterator end() { return iterator(nullptr); }
+    const_iterator begin() const { return const_iterator(head); }
+    const_iterator end() const { return const_iterator(nullptr); }
+
+private:
+    static int lowestBit(uint64_t bits) {
+#if defined(__GNUC__)
+        return __builtin_ctzll(bits);
+#else
+        int i = 0;
+        while (!(bits & 1)) {
+            bits >>= 1;
+            i++;
+        }
+        return i;
+#endif
+    }
+
+    static int highestBit(uint64_t bits) {
+#if defined(__GNUC__)
+        return 63 - __builtin_clzll(bits);
+#else
+        int i = 63;
+        while (!(bits & ((uint64_t)1 << i))) i--;
+        return i;
+#endif
+    }
+
+    static int lowestSlot(const Chunk* c) { return lowestBit(c->occupied); }
+    static int highestSlot(const Chunk* c) { return highestBit(c->occupied); }
+
+    void appendChunk() {
+        Chunk* c = pool ? pool->create() : new Chunk();
+        c->prev = tail;
+        if (tail) tail->next = c;
+        else head = c;
+        tail = c;
+    }
+
+    void unlink(Chunk* c) {
+        if (c->prev) c->prev->next = c->next;
+        else head = c->next;
+        if (c->next) c->next->prev = c->prev;
+        else tail = c->prev;
+        freeChunk(c);
+    }
+
+    void freeChunk(Chunk* c) {
+        if (pool) pool->destroy(c);
+        else delete c;
+    }
+
+    Chunk* head;
+    Chunk* tail;
+    size_t count;
+    ObjectPool<Chunk>* pool;
+};
+
+#endif // UNROLLEDLIST_H
@@ -5,16 +5,37 @@
 #include <QGraphicsLineItem>
 #include <QPen>
 #include <QBrush>
+#include <QFont>
 #include <QGraphicsSceneMouseEvent>
 #include "Graph.h"
 
 class GraphView; // Forward declaration
+class VisualEdge;
+
+// Level of detail, as given by QStyleOptionGraphicsItem::levelOfDetailFromTransform
+// (1 = 100% zoom). Below each level the items drop part of their styling:
+// shadows, then node labels and edge weights, then gradients and
+// antialiasing (flat dots and hairlines).
+static const qreal kLodShadows = 0.6;
+static const qreal kLodLabels = 0.45;
+static const qreal kLodFlat = 0.25;
+
+// Shared by every item instead of one QFont per label
+const QFont& nodeLabelFont();
+const QFont& edgeWeightFont();
+
+// Edge items attached to a node, so moving it only touches those
+typedef UnrolledList<VisualEdge*, 8> VisualEdgeList;
 
 class VisualNode : public QGraphicsEllipseItem {
 public:
     VisualNode(Vertex* v, GraphView* view);
     
     Vertex* getVertex() const { return vertex; }
+    VisualEdgeList& incidentEdges() { return edges; }
+
+    QRectF boundingRect() const override; // the circle and its label
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = nullptr) override;
     
     // Qt Events
     void mousePressEvent(QGraphicsSceneMouseEvent *event) override;
@@ -33,7 +54,11 @@ protected:
 private:
     Vertex* vertex;
     GraphView* view;
+    bool highlighted;
     QPointF oldPos;
+    VisualEdgeList edges;
+    QString labelText;
+    QRectF labelRect;
 };
 
 class VisualEdge : public QGraphicsLineItem {
@@ -42,6 +67,15 @@ public:
     
     Edge* getEdge() const { return edgeRaw; }
     void updatePosition();
+    // Takes the edge off its nodes' lists; call before deleting it while
+    // the nodes are still alive (scene->clear() takes everything at once)
+    void detach();
+
+    // Set while the edge waits in GraphView's coalesced update list
+    bool updatePending;
+
+    QRectF boundingRect() const override; // the line and its weight
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = nullptr) override;
     
     void setHighlighted(bool high);
 
@@ -52,7 +86,11 @@ private:
     Edge* edgeRaw;
     VisualNode* sourceNode;
     VisualNode* destNode;
-    QGraphicsTextItem* weightLabel; // New member added
+    VisualEdgeList::Position sourcePos;
+    VisualEdgeList::Position destPos;
+    QString weightText;
+    QSizeF weightSize;
+    QRectF weightRect() const; // centered on the line
 };
 
 #endif // VISUALITEMS_H
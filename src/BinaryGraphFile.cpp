@@ -0,0 +1,249 @@
+#include "BinaryGraphFile.h"
+#include "CompactGraph.h"
+#include <climits>
+#include <cstdio>
+#include <cstring>
+
+static uint64_t align8(uint64_t offset) {
+    return (offset + 7) & ~(uint64_t)7;
+}
+
+BinaryGraphFile::BinaryGraphFile()
+    : header(nullptr), vertexTable(nullptr), stringPool(nullptr), offsets(nullptr), targets(nullptr), weights(nullptr) {}
+
+// True if every edge u -> v of the CSR has its v -> u copy, as an undirected
+// graph's CSR does. Rows must already be free of repeated targets; a self
+// loop is left out of the comparison (it is its own reverse). Builds the
+// transpose, O(n + m) time and memory.
+static bool symmetricRows(const int32_t* offsets, const int32_t* targets, int n) {
+    int m = offsets[n];
+    int32_t* tOffsets = new int32_t[n + 1]();
+    int32_t* tSources = new int32_t[m > 0 ? m : 1];
+    int32_t* mark = new int32_t[n > 0 ? n : 1];
+    for (int s = 0; s < m; ++s) tOffsets[targets[s] + 1]++;
+    for (int v = 0; v < n; ++v) tOffsets[v + 1] += tOffsets[v];
+    int32_t* cursor = mark; // fill positions, then reused for the marks
+    for (int v = 0; v < n; ++v) cursor[v] = tOffsets[v];
+    for (int u = 0; u < n; ++u) {
+        for (int s = offsets[u]; s < offsets[u + 1]; ++s) tSources[cursor[targets[s]]++] = u;
+    }
+
+    // Row v and the sources pointing at v must be the same set
+    for (int v = 0; v < n; ++v) mark[v] = -1;
+    bool symmetric = true;
+    for (int v = 0; v < n && symmetric; ++v) {
+        int outside = 0;
+        for (int s = offsets[v]; s < offsets[v + 1]; ++s) {
+            if (targets[s] == v) continue;
+            mark[targets[s]] = v;
+            outside++;
+        }
+        for (int s = tOffsets[v]; s < tOffsets[v + 1]; ++s) {
+            int u = tSources[s];
+            if (u == v) continue;
+            if (mark[u] != v) {
+                symmetric = false;
+                break;
+            }
+            outside--;
+        }
+        if (outside != 0) symmetric = false;
+    }
+    delete[] tOffsets;
+    delete[] tSources;
+    delete[] mark;
+    return symmetric;
+}
+
+bool BinaryGraphFile::hasMagic(const char* data, size_t size) {
+    return data && size >= sizeof(kBinaryGraphMagic) && std::memcmp(data, kBinaryGraphMagic, sizeof(kBinaryGraphMagic)) == 0;
+}
+
+bool BinaryGraphFile::fail(const std::string& why) {
+    message = why;
+    close();
+    return false;
+}
+
+void BinaryGraphFile::close() {
+    file.close();
+    header = nullptr;
+    vertexTable = nullptr;
+    stringPool = nullptr;
+    offsets = targets = weights = nullptr;
+}
+
+bool BinaryGraphFile::open(const std::string& path) {
+    close();
+    message.clear();
+    if (!file.open(path)) return fail("no se pudo abrir el archivo");
+
+    const char* base = file.data();
+    uint64_t size = file.size();
+    if (size < sizeof(BinaryGraphHeader) || !hasMagic(base, size)) return fail("no es un archivo .graphb");
+    header = (const BinaryGraphHeader*)base;
+    if (header->byteOrder != kBinaryGraphByteOrder) return fail("orden de bytes distinto al de esta máquina");
+    if (header->version != kBinaryGraphVersion) return fail("versión de formato no soportada");
+    if (header->fileSize != size) return fail("archivo truncado");
+
+    uint64_t n = header->vertexCount;
+    uint64_t m = header->edgeCount;
+    if (n > INT_MAX || m > INT_MAX) return fail("demasiados vértices o aristas");
+
+    // Every section aligned and inside the file
+    auto section = [&](uint64_t offset, uint64_t bytes) {
+        return offset % 8 == 0 && offset >= sizeof(BinaryGraphHeader) && offset <= size && bytes <= size - offset;
+    };
+    if (!section(header->vertexTableOffset, n * sizeof(BinaryVertexRecord)) ||
+        !section(header->stringPoolOffset, header->stringPoolBytes) ||
+        !section(header->offsetsOffset, (n + 1) * sizeof(int32_t)) ||
+        !section(header->targetsOffset, m * sizeof(int32_t)) ||
+        !section(header->weightsOffset, m * sizeof(int32_t))) {
+        return fail("secciones fuera de los límites del archivo");
+    }
+    vertexTable = (const BinaryVertexRecord*)(base + header->vertexTableOffset);
+    stringPool = base + header->stringPoolOffset;
+    offsets = (const int32_t*)(base + header->offsetsOffset);
+    targets = (const int32_t*)(base + header->targetsOffset);
+    weights = (const int32_t*)(base + header->weightsOffset);
+
+    // Indices must be usable without further checks
+    for (uint64_t i = 0; i < n; ++i) {
+        const BinaryVertexRecord& r = vertexTable[i];
+        if (r.labelOffset > header->stringPoolBytes || r.labelLength > header->stringPoolBytes - r.labelOffset) {
+            return fail("etiqueta fuera del bloque de cadenas");
+        }
+    }
+    if (offsets[0] != 0 || (uint64_t)offsets[n] != m) return fail("tabla de desplazamientos inválida");
+    for (uint64_t i = 0; i < n; ++i) {
+        if (offsets[i] > offsets[i + 1]) return fail("tabla de desplazamientos inválida");
+    }
+    for (uint64_t s = 0; s < m; ++s) {
+        if (targets[s] < 0 || (uint64_t)targets[s] >= n) return fail("arista hacia un vértice inexistente");
+    }
+
+    // toGraph adds edges without lookups, so each connection must be stored
+    // once per direction: no target repeated within a row (an undirected self
+    // loop fills its row twice) and, undirected, every edge with its reverse
+    bool directed = isDirected();
+    int32_t* seenFrom = new int32_t[n > 0 ? n : 1]; // row that last listed each target
+    for (uint64_t v = 0; v < n; ++v) seenFrom[v] = -1;
+    bool repeated = false;
+    for (int u = 0; u < (int)n && !repeated; ++u) {
+        int selfCopies = 0;
+        for (int s = offsets[u]; s < offsets[u + 1]; ++s) {
+            int v = targets[s];
+            if (v == u && !directed) {
+                if (++selfCopies > 2) repeated = true;
+            } else if (seenFrom[v] == u) {
+                repeated = true;
+            }
+            seenFrom[v] = u;
+        }
+    }
+    delete[] seenFrom;
+    if (repeated) return fail("arista repetida");
+    if (!directed && !symmetricRows(offsets, targets, (int)n)) return fail("arista no dirigida sin su copia inversa");
+    return true;
+}
+
+Graph* BinaryGraphFile::toGraph() const {
+    if (!header) return nullptr;
+    int n = vertexCount();
+    bool directed = isDirected();
+    Graph* graph = new Graph(directed, isWeighted());
+    graph->reserve(n);
+
+    Vertex** byIndex = new Vertex*[n > 0 ? n : 1];
+    for (int i = 0; i < n; ++i) {
+        byIndex[i] = graph->addVertex(vertexTable[i].id, labelAt(i), vertexTable[i].x, vertexTable[i].y);
+        if (!byIndex[i]) { // repeated ID
+            delete[] byIndex;
+            delete graph;
+            return nullptr;
+        }
+    }
+
+    // open() checked that no row repeats a target and, undirected, that
+    // every edge has its reverse, so edges go in without lookups.
+    // Undirected connections are stored twice: keep the u <= v copy
+    // (appendEdge adds the twin), and one of the copies of a self loop.
+    for (int u = 0; u < n; ++u) {
+        bool selfLoopDone = false;
+        for (int s = offsets[u]; s < offsets[u + 1]; ++s) {
+            int v = targets[s];
+            if (!directed) {
+                if (v < u) continue;
+                if (v == u) {
+                    if (selfLoopDone) continue;
+                    selfLoopDone = true;
+                }
+            }
+            graph->appendEdge(byIndex[u], byIndex[v], weights[s]);
+        }
+    }
+    delete[] byIndex;
+    return graph;
+}
+
+bool BinaryGraphFile::write(Graph* graph, const std::string& path) {
+    CompactGraph cg(graph);
+    uint64_t n = cg.vertexCount();
+    uint64_t m = cg.edgeCount();
+
+    BinaryGraphHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, kBinaryGraphMagic, sizeof(h.magic));
+    h.version = kBinaryGraphVersion;
+    h.byteOrder = kBinaryGraphByteOrder;
+    h.flags = (cg.isDirected() ? (uint32_t)BinaryGraphDirected : 0u) |
+              (cg.isWeighted() ? (uint32_t)BinaryGraphWeighted : 0u);
+    h.vertexCount = n;
+    h.edgeCount = m;
+    for (uint64_t i = 0; i < n; ++i) h.stringPoolBytes += cg.vertexAt((int)i)->label.size();
+    h.vertexTableOffset = sizeof(BinaryGraphHeader);
+    h.stringPoolOffset = align8(h.vertexTableOffset + n * sizeof(BinaryVertexRecord));
+    h.offsetsOffset = align8(h.stringPoolOffset + h.stringPoolBytes);
+    h.targetsOffset = align8(h.offsetsOffset + (n + 1) * sizeof(int32_t));
+    h.weightsOffset = align8(h.targetsOffset + m * sizeof(int32_t));
+    h.fileSize = h.weightsOffset + m * sizeof(int32_t);
+
+    std::FILE* out = std::fopen(path.c_str(), "wb");
+    if (!out) return false;
+    std::setvbuf(out, nullptr, _IOFBF, 1 << 20);
+
+    uint64_t written = 0;
+    auto put = [&](const void* data, uint64_t bytes) {
+        if (bytes && std::fwrite(data, 1, bytes, out) != bytes) return false;
+        written += bytes;
+        return true;
+    };
+    auto padTo = [&](uint64_t offset) {
+        static const char zeros[8] = {0};
+        return put(zeros, offset - written);
+    };
+
+    bool ok = put(&h, sizeof(h));
+    uint64_t labelOffset = 0;
+    for (uint64_t i = 0; ok && i < n; ++i) {
+        BinaryVertexRecord r;
+        r.id = cg.idAt((int)i);
+        r.x = cg.xAt((int)i);
+        r.y = cg.yAt((int)i);
+        r.labelLength = (uint32_t)cg.vertexAt((int)i)->label.size();
+        r.labelOffset = labelOffset;
+        labelOffset += r.labelLength;
+        ok = put(&r, sizeof(r));
+    }
+    ok = ok && padTo(h.stringPoolOffset);
+    for (uint64_t i = 0; ok && i < n; ++i) {
+        const std::string& label = cg.vertexAt((int)i)->label;
+        ok = put(label.data(), label.size());
+    }
+    ok = ok && padTo(h.offsetsOffset) && put(cg.offsetArray(), (n + 1) * sizeof(int32_t));
+    ok = ok && padTo(h.targetsOffset) && put(cg.targetArray(), m * sizeof(int32_t));
+    ok = ok && padTo(h.weightsOffset) && put(cg.weightArray(), m * sizeof(int32_t));
+
+    if (std::fclose(out) != 0) ok = false;
+    return ok && written == h.fileSize;
+}
@@ -0,0 +1,120 @@
+#include "CompactGraph.h"
+#include <cmath>
+
+CompactGraph::CompactGraph(Graph* graph, bool withReverse)
+    : directed(graph->isDirected()), weighted(graph->isWeighted()),
+      revOffsets(nullptr), revSources(nullptr), revWeights(nullptr), revSlots(nullptr), weightPerLength(-1)
+{
+    n = graph->getVertices().size();
+    ids = new int[n];
+    vertices = new Vertex*[n];
+    xs = new int[n];
+    ys = new int[n];
+    offsets = new int[n + 1];
+    indexById.reserve(n);
+
+    // First pass: dense indices and degree prefix sums
+    int i = 0;
+    m = 0;
+    for (auto v : graph->getVertices()) {
+        ids[i] = v->id;
+        vertices[i] = v;
+        xs[i] = v->x;
+        ys[i] = v->y;
+        indexById.insert(v->id, i);
+        offsets[i] = m;
+        m += v->edges.size();
+        i++;
+    }
+    offsets[n] = m;
+
+    // Second pass: fill the edge arrays
+    targets = new int[m];
+    weights = new int[m];
+    edges = new Edge*[m];
+    int slot = 0;
+    for (i = 0; i < n; ++i) {
+        for (auto e : vertices[i]->edges) {
+            targets[slot] = *indexById.find(e->dest->id);
+            weights[slot] = e->weight;
+            edges[slot] = e;
+            slot++;
+        }
+    }
+
+    if (withReverse) buildReverse();
+}
+
+// Concurrent first calls each compute the same value, so a plain atomic
+// store is enough
+double CompactGraph::minWeightPerLength() const {
+    double known = weightPerLength.load(std::memory_order_relaxed);
+    if (known >= 0) return known;
+    double ratio = -1;
+    for (int u = 0; u < n && ratio != 0; ++u) {
+        for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+            if (weights[e] < 0) { ratio = 0; break; }
+            double dx = xs[u] - xs[targets[e]];
+            double dy = ys[u] - ys[targets[e]];
+            double len = std::sqrt(dx * dx + dy * dy);
+            if (len > 0) {
+                double r = weights[e] / len;
+                if (ratio < 0 || r < ratio) ratio = r;
+            }
+        }
+    }
+    if (ratio < 0) ratio = 0;
+    weightPerLength.store(ratio, std::memory_order_relaxed);
+    return ratio;
+}
+
+// Counting sort of the edge slots by target: in-degree prefix sums, then one
+// scatter pass
+void CompactGraph::buildReverse() {
+    revOffsets = new int[n + 1];
+    revSources = new int[m];
+    revWeights = new int[m];
+    revSlots = new int[m];
+
+    for (int i = 0; i <= n; ++i) revOffsets[i] = 0;
+    for (int s = 0; s < m; ++s) revOffsets[targets[s] + 1]++;
+    for (int i = 0; i < n; ++i) revOffsets[i + 1] += revOffsets[i];
+
+    int* fill = new int[n];
+    for (int i = 0; i < n; ++i) fill[i] = revOffsets[i];
+    for (int u = 0; u < n; ++u) {
+        for (int s = offsets[u]; s < offsets[u + 1]; ++s) {
+            int r = fill[targets[s]]++;
+            revSources[r] = u;
+            revWeights[r] = weights[s];
+            revSlots[r] = s;
+        }
+    }
+    delete[] fill;
+}
+
+CompactGraph::~CompactGraph() {
+    delete[] offsets;
+    delete[] targets;
+    delete[] weights;
+    delete[] edges;
+    delete[] ids;
+    delete[] vertices;
+    delete[] xs;
+    delete[] ys;
+    delete[] revOffsets;
+    delete[] revSources;
+    delete[] revWeights;
+    delete[] revSlots;
+}
+
+int CompactGraph::indexOf(int id) const {
+    const int* found = indexById.find(id);
+    return found ? *found : -1;
+}
+
+int* CompactGraph::copyIdMap() const {
+    int* idMap = new int[n];
+    for (int i = 0; i < n; ++i) idMap[i] = ids[i];
+    return idMap;
+}
@@ -0,0 +1,267 @@
+#include "CompressedGraphFile.h"
+#include "CompactGraph.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+
+static inline uint64_t zigzag(int64_t v) {
+    return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63);
+}
+
+static inline int64_t unzigzag(uint64_t v) {
+    return (int64_t)(v >> 1) ^ -(int64_t)(v & 1);
+}
+
+static void putVarint(std::string& out, uint64_t v) {
+    char bytes[10];
+    int k = 0;
+    while (v >= 0x80) {
+        bytes[k++] = (char)(v | 0x80);
+        v >>= 7;
+    }
+    bytes[k++] = (char)v;
+    out.append(bytes, k);
+}
+
+// Bounds-checked varint reader; once a read fails every later one does too
+struct VarintReader {
+    const unsigned char* p;
+    const unsigned char* end;
+    bool ok;
+
+    uint64_t next() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            if (p == end) break;
+            unsigned char byte = *p++;
+            value |= (uint64_t)(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) return value;
+        }
+        ok = false;
+        return 0;
+    }
+
+    // Signed value that must fit an int. `base` is an int, so no delta of
+    // 2^32 or more can land in range; such codes are rejected before the
+    // addition, which could otherwise overflow.
+    bool nextInt(int64_t base, int32_t& out) {
+        uint64_t code = next();
+        if (code >> 33) return ok = false;
+        int64_t v = base + unzigzag(code);
+        if (!ok || v < INT_MIN || v > INT_MAX) return ok = false;
+        out = (int32_t)v;
+        return true;
+    }
+};
+
+CompressedGraphFile::CompressedGraphFile()
+    : n(0), m(0), directed(false), weighted(false), ids(nullptr), xs(nullptr), ys(nullptr), labels(nullptr),
+      offsets(nullptr), targets(nullptr), weights(nullptr) {}
+
+CompressedGraphFile::~CompressedGraphFile() {
+    clear();
+}
+
+void CompressedGraphFile::clear() {
+    delete[] ids;
+    delete[] xs;
+    delete[] ys;
+    delete[] labels;
+    delete[] offsets;
+    delete[] targets;
+    delete[] weights;
+    ids = xs = ys = offsets = targets = weights = nullptr;
+    labels = nullptr;
+    n = m = 0;
+}
+
+bool CompressedGraphFile::fail(const std::string& why) {
+    message = why;
+    clear();
+    return false;
+}
+
+bool CompressedGraphFile::hasMagic(const char* data, size_t size) {
+    return data && size >= sizeof(kCompressedGraphMagic) &&
+           std::memcmp(data, kCompressedGraphMagic, sizeof(kCompressedGraphMagic)) == 0;
+}
+
+bool CompressedGraphFile::open(const std::string& path) {
+    MappedFile file;
+    if (!file.open(path)) {
+        clear();
+        message = "no se pudo abrir el archivo";
+        return false;
+    }
+    return decode(file.data(), file.size());
+}
+
+bool CompressedGraphFile::decode(const char* data, size_t size) {
+    clear();
+    message.clear();
+    if (size < sizeof(CompressedGraphHeader) || !hasMagic(data, size)) return fail("no es un archivo .graphz");
+    CompressedGraphHeader h;
+    std::memcpy(&h, data, sizeof(h));
+    if (h.version != kCompressedGraphVersion) return fail("versión de formato no soportada");
+    if (h.fileSize != size) return fail("archivo truncado");
+    // Every vertex and edge takes at least one byte, which also bounds the
+    // allocations below by the file size
+    if (h.vertexCount > INT_MAX || h.edgeCount > INT_MAX || h.vertexCount + h.edgeCount > size) {
+        return fail("demasiados vértices o aristas");
+    }
+
+    n = (int)h.vertexCount;
+    m = (int)h.edgeCount;
+    directed = (h.flags & CompressedGraphDirected) != 0;
+    weighted = (h.flags & CompressedGraphWeighted) != 0;
+    bool hasWeights = (h.flags & CompressedGraphHasWeights) != 0;
+    ids = new int32_t[n];
+    xs = new int32_t[n];
+    ys = new int32_t[n];
+    labels = new std::string[n];
+    offsets = new int32_t[n + 1];
+    targets = new int32_t[m];
+    weights = new int32_t[m];
+
+    VarintReader in{(const unsigned char*)data + sizeof(h), (const unsigned char*)data + size, true};
+    int32_t previousId = 0;
+    for (int i = 0; i < n; ++i) {
+        if (!in.nextInt(previousId, ids[i]) || !in.nextInt(0, xs[i]) || !in.nextInt(0, ys[i])) break;
+        previousId = ids[i];
+        uint64_t length = in.next();
+        if (!in.ok || length > (uint64_t)(in.end - in.p)) return fail("etiqueta fuera del archivo");
+        labels[i].assign((const char*)in.p, (size_t)length);
+        in.p += length;
+    }
+    if (!in.ok) return fail("tabla de vértices dañada");
+
+    int slot = 0;
+    for (int u = 0; u < n && in.ok; ++u) {
+        offsets[u] = slot;
+        uint64_t degree = in.next();
+        if (degree > (uint64_t)(m - slot)) return fail("más aristas de las declaradas");
+        int64_t v = u;
+        for (uint64_t k = 0; k < degree; ++k) {
+            uint64_t code = in.next();
+            // Deltas between vertex indices stay under n in magnitude;
+            // checked first so the sums below can't overflow
+            if (code >= 2 * (uint64_t)n) return fail("arista hacia un vértice inexistente");
+            v = (k == 0) ? u + unzigzag(code) : v + (int64_t)code;
+            if (!in.ok || v < 0 || v >= n) return fail("arista hacia un vértice inexistente");
+            if (!directed && v < u) return fail("arista no dirigida guardada dos veces");
+            targets[slot] = (int32_t)v;
+            if (!hasWeights) weights[slot] = 1;
+            else if (!in.nextInt(0, weights[slot])) break;
+            slot++;
+        }
+    }
+    if (!in.ok) return fail("lista de adyacencia dañada");
+    if (slot != m || in.p != in.end) return fail("número de aristas distinto al declarado");
+    offsets[n] = m;
+    return true;
+}
+
+Graph* CompressedGraphFile::toGraph() const {
+    Graph* graph = new Graph(directed, weighted);
+    graph->reserve(n);
+    Vertex** byIndex = new Vertex*[n > 0 ? n : 1];
+    for (int i = 0; i < n; ++i) {
+        byIndex[i] = graph->addVertex(ids[i], labels[i], xs[i], ys[i]);
+        if (!byIndex[i]) { // repeated ID
+            delete[] byIndex;
+            delete graph;
+            return nullptr;
+        }
+    }
+    // Each stored edge is one connection (undirected ones get their twin
+    // from appendEdge); a damaged file could repeat a neighbour, so those
+    // go through the checked addEdge.
+    for (int u = 0; u < n; ++u) {
+        for (int s = offsets[u]; s < offsets[u + 1]; ++s) {
+            if (s > offsets[u] && targets[s] == targets[s - 1]) graph->addEdge(byIndex[u], byIndex[targets[s]], weights[s]);
+            else graph->appendEdge(byIndex[u], byIndex[targets[s]], weights[s]);
+        }
+    }
+    delete[] byIndex;
+    return graph;
+}
+
+struct NeighbourEntry {
+    int target;
+    int weight;
+    bool operator<(const NeighbourEntry& other) const { return target < other.target; }
+};
+
+bool CompressedGraphFile::write(Graph* graph, const std::string& path) {
+    CompactGraph cg(graph);
+    int count = cg.vertexCount();
+    bool undirected = !cg.isDirected();
+
+    bool hasWeights = false;
+    for (int s = 0; s < cg.edgeCount() && !hasWeights; ++s) hasWeights = cg.weight(s) != 1;
+
+    std::string out;
+    out.reserve(sizeof(CompressedGraphHeader) + (size_t)count * 8 + (size_t)cg.edgeCount() * (hasWeights ? 3 : 2));
+    out.resize(sizeof(CompressedGraphHeader));
+
+    int64_t previousId = 0;
+    for (int i = 0; i < count; ++i) {
+        putVarint(out, zigzag((int64_t)cg.idAt(i) - previousId));
+        previousId = cg.idAt(i);
+        putVarint(out, zigzag(cg.xAt(i)));
+        putVarint(out, zigzag(cg.yAt(i)));
+        const std::string& label = cg.vertexAt(i)->label;
+        putVarint(out, label.size());
+        out.append(label);
+    }
+
+    // Sorted per vertex; the largest degree bounds the scratch list
+    int maxDegree = 0;
+    for (int u = 0; u < count; ++u) maxDegree = std::max(maxDegree, cg.edgeEnd(u) - cg.edgeBegin(u));
+    NeighbourEntry* list = new NeighbourEntry[maxDegree > 0 ? maxDegree : 1];
+    uint64_t stored = 0;
+    for (int u = 0; u < count; ++u) {
+        int degree = 0;
+        bool selfLoopDone = false;
+        for (int s = cg.edgeBegin(u); s < cg.edgeEnd(u); ++s) {
+            int v = cg.target(s);
+            if (undirected) {
+                if (v < u) continue;
+                if (v == u) {
+                    if (selfLoopDone) continue; // both halves of an undirected loop sit here
+                    selfLoopDone = true;
+                }
+            }
+            list[degree++] = NeighbourEntry{v, cg.weight(s)};
+        }
+        std::sort(list, list + degree);
+        putVarint(out, degree);
+        for (int k = 0; k < degree; ++k) {
+            if (k == 0) putVarint(out, zigzag((int64_t)list[k].target - u));
+            else putVarint(out, (uint64_t)(list[k].target - list[k - 1].target));
+            if (hasWeights) putVarint(out, zigzag(list[k].weight));
+        }
+        stored += degree;
+    }
+    delete[] list;
+
+    CompressedGraphHeader h;
+    std::memset(&h, 0, sizeof(h));
+    std::memcpy(h.magic, kCompressedGraphMagic, sizeof(h.magic));
+    h.version = kCompressedGraphVersion;
+    h.flags = (cg.isDirected() ? (uint32_t)CompressedGraphDirected : 0u) |
+              (cg.isWeighted() ? (uint32_t)CompressedGraphWeighted : 0u) |
+              (hasWeights ? (uint32_t)CompressedGraphHasWeights : 0u);
+    h.vertexCount = count;
+    h.edgeCount = stored;
+    h.fileSize = out.size();
+    std::memcpy(&out[0], &h, sizeof(h));
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool ok = std::fwrite(out.data(), 1, out.size(), file) == out.size();
+    if (std::fclose(file) != 0) ok = false;
+    return ok;
+}
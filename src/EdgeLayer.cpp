@@ -0,0 +1,148 @@
+#include "EdgeLayer.h"
+#include "VisualItems.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <cstring>
+
+// Room around the segments for the pen and the weight labels
+static const qreal kMargin = 20;
+
+EdgeLayer::EdgeLayer() : entries(nullptr), capacity(0) {
+    setZValue(-1); // Behind nodes, like VisualEdge
+    setFlag(ItemUsesExtendedStyleOption); // exact exposedRect for paint
+    setAcceptedMouseButtons(Qt::NoButton); // clicks go to the nodes or the view
+}
+
+EdgeLayer::~EdgeLayer() {
+    delete[] entries;
+}
+
+int EdgeLayer::addEdge(Edge* e, VisualNode* src, VisualNode* dest) {
+    QPointF p1 = src->pos(), p2 = dest->pos();
+    int slot = index.add(p1.x(), p1.y(), p2.x(), p2.y());
+    if (slot >= capacity) {
+        int bigger = capacity == 0 ? 1024 : capacity * 2;
+        while (bigger <= slot) bigger *= 2;
+        Slot* grown = new Slot[bigger];
+        if (capacity) std::memcpy(grown, entries, capacity * sizeof(Slot));
+        delete[] entries;
+        entries = grown;
+        capacity = bigger;
+    }
+    entries[slot] = Slot{e, src, dest, false, false};
+    place(slot);
+    return slot;
+}
+
+void EdgeLayer::removeEdge(int slot) {
+    if (entries[slot].moved) movedSlots.remove(slot);
+    if (entries[slot].highlighted) highlightedSlots.remove(slot);
+    update(segmentRect(slot));
+    index.remove(slot);
+}
+
+QRectF EdgeLayer::segmentRect(int slot) const {
+    const float* s = index.segment(slot);
+    return QRectF(QPointF(s[0], s[1]), QPointF(s[2], s[3])).normalized().adjusted(-kMargin, -kMargin, kMargin, kMargin);
+}
+
+void EdgeLayer::place(int slot) {
+    QRectF before = segmentRect(slot);
+    QPointF p1 = entries[slot].source->pos(), p2 = entries[slot].dest->pos();
+    index.move(slot, p1.x(), p1.y(), p2.x(), p2.y());
+    QRectF after = segmentRect(slot);
+    if (bounds.isNull()) {
+        prepareGeometryChange();
+        bounds = after;
+    } else if (!bounds.contains(after.topLeft()) || !bounds.contains(after.bottomRight())) {
+        prepareGeometryChange();
+        bounds = bounds.united(after);
+    }
+    update(before.united(after));
+}
+
+void EdgeLayer::refresh(int slot) {
+    place(slot);
+}
+
+void EdgeLayer::markMoved(int slot) {
+    if (entries[slot].moved) return;
+    entries[slot].moved = true;
+    movedSlots.push_back(slot);
+}
+
+void EdgeLayer::flushMoved() {
+    for (int slot : movedSlots) {
+        entries[slot].moved = false;
+        place(slot);
+    }
+    movedSlots.clear();
+}
+
+void EdgeLayer::setHighlighted(int slot, bool high) {
+    if (entries[slot].highlighted == high) return;
+    entries[slot].highlighted = high;
+    if (high) highlightedSlots.push_back(slot);
+    else highlightedSlots.remove(slot);
+    update(segmentRect(slot));
+}
+
+void EdgeLayer::clearHighlights() {
+    for (int slot : highlightedSlots) {
+        entries[slot].highlighted = false;
+        update(segmentRect(slot));
+    }
+    highlightedSlots.clear();
+}
+
+Edge* EdgeLayer::edgeAt(const QPointF& pos, qreal tolerance) const {
+    int slot = index.nearest(pos.x(), pos.y(), tolerance);
+    return slot == -1 ? nullptr : entries[slot].edge;
+}
+
+bool EdgeLayer::contains(const QPointF& point) const {
+    return index.nearest(point.x(), point.y(), 3) != -1;
+}
+
+QRectF EdgeLayer::boundingRect() const {
+    return bounds;
+}
+
+void EdgeLayer::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *) {
+    // Labels and the wide highlight pen reach past a segment's box, as in
+    // segmentRect(): a segment just outside the exposed rect can still paint
+    // into it
+    QRectF area = option->exposedRect.adjusted(-kMargin, -kMargin, kMargin, kMargin);
+    normalLines.clear();
+    highlightedLines.clear();
+    visible.clear();
+    index.query(area.left(), area.top(), area.right(), area.bottom(), [&](int slot) {
+        const float* s = index.segment(slot);
+        (entries[slot].highlighted ? highlightedLines : normalLines).append(QLineF(s[0], s[1], s[2], s[3]));
+        visible.append(slot);
+    });
+
+    // Same look and levels of detail as VisualEdge
+    qreal lod = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    QPen normalPen(QColor(160, 160, 160), 2);
+    QPen highlightPen(QColor(255, 69, 0), 4);
+    if (lod < kLodFlat) {
+        normalPen.setWidthF(0);
+        highlightPen.setWidthF(0);
+        painter->setRenderHint(QPainter::Antialiasing, false);
+    }
+    painter->setPen(normalPen);
+    painter->drawLines(normalLines.constData(), normalLines.size());
+    painter->setPen(highlightPen);
+    painter->drawLines(highlightedLines.constData(), highlightedLines.size());
+
+    if (lod >= kLodLabels) {
+        painter->setFont(edgeWeightFont());
+        painter->setPen(QColor(180, 180, 180));
+        for (int slot : visible) {
+            const float* s = index.segment(slot);
+            QRectF around((s[0] + s[2]) / 2 - kMargin, (s[1] + s[3]) / 2 - kMargin, 2 * kMargin, 2 * kMargin);
+            painter->drawText(around, Qt::AlignCenter | Qt::TextDontClip, QString::number(entries[slot].edge->weight));
+        }
+    }
+}
@@ -1,93 +1,234 @@
 #include "FileController.h"
-#include <fstream>
-#include <sstream>
-#include <iostream>
-
-bool FileController::saveGraph(Graph* graph, const std::string& filename) {
-    std::ofstream outfile(filename);
-    if (!outfile.is_open()) return false;
-
-    outfile << "TYPE:" << (graph->isDirected() ? "DIRECTED" : "UNDIRECTED") << "\n";
-    outfile << "WEIGHTED:" << (graph->isWeighted() ? "TRUE" : "FALSE") << "\n";
-    
-    outfile << "NODES\n";
+#include "BinaryGraphFile.h"
+#include "CompressedGraphFile.h"
+#include "GraphTextParser.h"
+#include "MappedFile.h"
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstdio>
+#include <cstring>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+static bool endsWith(const std::string& text, const std::string& suffix) {
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+GraphFileFormat FileController::formatForFileName(const std::string& filename) {
+    if (endsWith(filename, ".graphb")) return GraphFileFormat::Binary;
+    if (endsWith(filename, ".graphz")) return GraphFileFormat::Compressed;
+    return GraphFileFormat::Text;
+}
+
+// Output buffer for the text format: numbers are formatted in place with
+// std::to_chars and the buffer goes to the file in 1 MB writes.
+class TextWriter {
+public:
+    explicit TextWriter(std::FILE* out) : out(out), buffer(new char[kBufferSize]), used(0), ok(true) {}
+    ~TextWriter() { delete[] buffer; }
+
+    TextWriter(const TextWriter&) = delete;
+    TextWriter& operator=(const TextWriter&) = delete;
+
+    void put(const char* text, size_t length) {
+        if (length > kBufferSize - used) flush();
+        if (length > kBufferSize) {
+            write(text, length);
+            return;
+        }
+        std::memcpy(buffer + used, text, length);
+        used += length;
+    }
+    void put(const std::string& text) { put(text.data(), text.size()); }
+    void put(const char* text) { put(text, std::strlen(text)); }
+
+    void put(int value) {
+        if (kBufferSize - used < 16) flush();
+        used = (size_t)(std::to_chars(buffer + used, buffer + kBufferSize, value).ptr - buffer);
+    }
+
+    void put(char c) {
+        if (used == kBufferSize) flush();
+        buffer[used++] = c;
+    }
+
+    // False if any write failed
+    bool finish() {
+        flush();
+        return ok;
+    }
+
+private:
+    static const size_t kBufferSize = 1 << 20;
+
+    void flush() {
+        write(buffer, used);
+        used = 0;
+    }
+    void write(const char* data, size_t length) {
+        if (length && std::fwrite(data, 1, length, out) != length) ok = false;
+    }
+
+    std::FILE* out;
+    char* buffer;
+    size_t used;
+    bool ok;
+};
+
+static bool writeTextGraph(Graph* graph, const std::string& path) {
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    std::setvbuf(file, nullptr, _IONBF, 0); // TextWriter already batches
+    TextWriter out(file);
+
+    out.put(graph->isDirected() ? "TYPE:DIRECTED\n" : "TYPE:UNDIRECTED\n");
+    out.put(graph->isWeighted() ? "WEIGHTED:TRUE\n" : "WEIGHTED:FALSE\n");
+    out.put("NODES\n");
     for (auto v : graph->getVertices()) {
-        outfile << v->id << "," << v->label << "," << v->x << "," << v->y << "\n";
+        out.put(v->id);
+        out.put(',');
+        out.put(v->label);
+        out.put(',');
+        out.put(v->x);
+        out.put(',');
+        out.put(v->y);
+        out.put('\n');
     }
 
-    outfile << "EDGES\n";
-    // Avoid duplicates for undirected? 
-    // Graph stores double edges for undirected. 
-    // If we save all, when loading undirected we might duplicate again if addEdge adds both.
-    // Logic: If undirected, only save if src < dest?
-    // Or just save all and handle duplicates on load. 
-    // Our addEdge checks for existence. So saving all is safe but redundant.
-    
+    // An undirected edge is stored once per direction (twins); write it once,
+    // from the endpoint with the smaller ID. Loading adds the other half.
+    out.put("EDGES\n");
     for (auto v : graph->getVertices()) {
         for (auto e : v->edges) {
-            outfile << e->source->id << "," << e->dest->id << "," << e->weight << "\n";
+            if (e->twin) {
+                if (e->source->id > e->dest->id) continue;
+                if (e->source == e->dest && e > e->twin) continue; // self-loop: both halves live here
+            }
+            out.put(e->source->id);
+            out.put(',');
+            out.put(e->dest->id);
+            out.put(',');
+            out.put(e->weight);
+            out.put('\n');
         }
     }
 
-    outfile.close();
-    return true;
+    bool ok = out.finish() && std::fflush(file) == 0;
+#ifdef _WIN32
+    ok = ok && _commit(_fileno(file)) == 0;
+#else
+    ok = ok && fsync(fileno(file)) == 0;
+#endif
+    if (std::fclose(file) != 0) ok = false;
+    return ok;
+}
+
+// Flushes a file that was written and closed elsewhere to disk
+static bool syncFile(const std::string& path) {
+#ifdef _WIN32
+    int fd = _open(path.c_str(), _O_RDWR | _O_BINARY);
+    if (fd < 0) return false;
+    bool ok = _commit(fd) == 0;
+    _close(fd);
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+    bool ok = fsync(fd) == 0;
+    close(fd);
+#endif
+    return ok;
+}
+
+// Moves `from` over `to` in one step: readers see the old file or the new
+// one, never a partial write
+static bool replaceFile(const std::string& from, const std::string& to) {
+#ifdef _WIN32
+    return MoveFileExA(from.c_str(), to.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+    return std::rename(from.c_str(), to.c_str()) == 0;
+#endif
 }
 
-Graph* FileController::loadGraph(const std::string& filename) {
-    std::ifstream infile(filename);
-    if (!infile.is_open()) return nullptr;
-
-    std::string line;
-    bool directed = false;
-    bool weighted = false;
-    
-    // Header
-    if (std::getline(infile, line)) {
-        if (line.find("DIRECTED") != std::string::npos) directed = true;
+// Picks a name next to `filename` and creates the file exclusively, so
+// nothing already there (a user's "x.graph.tmp", another save in flight) is
+// overwritten. The writers then reopen it.
+static bool createTempFile(const std::string& filename, std::string& temp) {
+    static std::atomic<unsigned> counter(0);
+#ifdef _WIN32
+    unsigned pid = (unsigned)GetCurrentProcessId();
+#else
+    unsigned pid = (unsigned)getpid();
+#endif
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        temp = filename + ".tmp." + std::to_string(pid) + "." + std::to_string(counter++);
+#ifdef _WIN32
+        int fd = _open(temp.c_str(), _O_CREAT | _O_EXCL | _O_WRONLY | _O_BINARY, _S_IREAD | _S_IWRITE);
+        if (fd >= 0) return _close(fd) == 0;
+#else
+        int fd = open(temp.c_str(), O_CREAT | O_EXCL | O_WRONLY, 0666);
+        if (fd >= 0) return close(fd) == 0;
+#endif
+        if (errno != EEXIST) return false;
     }
-    if (std::getline(infile, line)) {
-        if (line.find("WEIGHTED:TRUE") != std::string::npos) weighted = true;
+    return false;
+}
+
+bool FileController::saveGraph(Graph* graph, const std::string& filename, GraphFileFormat format) {
+    // Written next to the target and renamed over it at the end, so a crash
+    // or a full disk mid-save leaves the previous file intact
+    std::string temp;
+    if (!createTempFile(filename, temp)) return false;
+    bool ok;
+    switch (format) {
+    case GraphFileFormat::Binary:
+        ok = BinaryGraphFile::write(graph, temp) && syncFile(temp);
+        break;
+    case GraphFileFormat::Compressed:
+        ok = CompressedGraphFile::write(graph, temp) && syncFile(temp);
+        break;
+    default:
+        ok = writeTextGraph(graph, temp);
+        break;
+    }
+    if (!ok || !replaceFile(temp, filename)) {
+        std::remove(temp.c_str());
+        return false;
     }
+    return true;
+}
 
-    Graph* graph = new Graph(directed, weighted);
-    
-    std::string section = "";
-    while (std::getline(infile, line)) {
-        if (line == "NODES") { section = "NODES"; continue; }
-        if (line == "EDGES") { section = "EDGES"; continue; }
-        
-        if (section == "NODES") {
-             std::stringstream ss(line);
-             std::string segment;
-             std::string parts[4];
-             int i = 0;
-             while(std::getline(ss, segment, ',') && i < 4) {
-                parts[i++] = segment;
-             }
-             if(i >= 4) {
-                 int id = std::stoi(parts[0]);
-                 std::string label = parts[1];
-                 int x = std::stoi(parts[2]);
-                 int y = std::stoi(parts[3]);
-                 graph->addVertex(id, label, x, y);
-             }
-        } else if (section == "EDGES") {
-             std::stringstream ss(line);
-             std::string segment;
-             std::string parts[3];
-             int i = 0;
-             while(std::getline(ss, segment, ',') && i < 3) {
-                parts[i++] = segment;
-             }
-             if(i >= 3) {
-                 int src = std::stoi(parts[0]);
-                 int dest = std::stoi(parts[1]);
-                 int w = std::stoi(parts[2]);
-                 graph->addEdge(src, dest, w);
-             }
-        }
+Graph* FileController::loadGraph(const std::string& filename, std::string* problems, ThreadPool* pool) {
+    MappedFile file;
+    if (!file.open(filename)) return nullptr;
+
+    if (BinaryGraphFile::hasMagic(file.data(), file.size())) {
+        file.close();
+        BinaryGraphFile binary;
+        if (binary.open(filename)) return binary.toGraph();
+        if (problems) *problems = binary.error();
+        return nullptr;
+    }
+
+    if (CompressedGraphFile::hasMagic(file.data(), file.size())) {
+        CompressedGraphFile compressed;
+        if (compressed.decode(file.data(), file.size())) return compressed.toGraph();
+        if (problems) *problems = compressed.error();
+        return nullptr;
     }
 
-    infile.close();
+    GraphTextParser parser(file.data(), file.size());
+    Graph* graph = parser.parse(pool);
+    if (problems) *problems = parser.errorSummary();
     return graph;
 }
@@ -0,0 +1,227 @@
+#include "FloydWarshall.h"
+#include "ThreadPool.h"
+#include <cstdint>
+#include <cassert>
+#include <climits>
+#include <cstdlib>
+#include <new>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define FW_X86_SIMD 1
+#define FW_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#elif defined(_MSC_VER) && defined(_M_X64)
+#define FW_X86_SIMD 1
+#define FW_TARGET(isa)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+
+// Tile edge in ints: three 64x64 tiles (48 KB) stay in L2 during a phase
+static const int kTile = 64;
+
+// ================= Matrix storage =================
+
+int distanceMatrixStride(int n) {
+    return (n + 15) & ~15;
+}
+
+int** allocDistanceMatrix(int n) {
+    int stride = distanceMatrixStride(n);
+    size_t bytes = (size_t)stride * (n > 0 ? n : 1) * sizeof(int);
+
+    // Manual 64-byte alignment (std::aligned_alloc is missing on MSVC):
+    // over-allocate and keep the original pointer just before the block
+    void* raw = std::malloc(bytes + 64 + sizeof(void*));
+    if (!raw) throw std::bad_alloc(); // same as the new[] below
+    uintptr_t start = ((uintptr_t)raw + sizeof(void*) + 63) & ~(uintptr_t)63;
+    ((void**)start)[-1] = raw;
+    int* block = (int*)start;
+
+    int** rows = new int*[n > 0 ? n : 1];
+    rows[0] = block;
+    for (int i = 1; i < n; ++i) rows[i] = block + (size_t)i * stride;
+    return rows;
+}
+
+void freeDistanceMatrix(int** matrix) {
+    if (!matrix) return;
+    std::free(((void**)matrix[0])[-1]);
+    delete[] matrix;
+}
+
+// ================= Min-plus kernels =================
+
+typedef void (*MinPlusFn)(int* row, const int* rowK, int dik, int count);
+
+static void minPlusScalar(int* row, const int* rowK, int dik, int count) {
+    for (int j = 0; j < count; ++j) {
+        int candidate = dik + rowK[j];
+        if (candidate < row[j]) row[j] = candidate;
+    }
+}
+
+#ifdef FW_X86_SIMD
+FW_TARGET("sse4.1")
+static void minPlusSSE41(int* row, const int* rowK, int dik, int count) {
+    __m128i add = _mm_set1_epi32(dik);
+    int j = 0;
+    for (; j + 4 <= count; j += 4) {
+        __m128i k = _mm_loadu_si128((const __m128i*)(rowK + j));
+        __m128i r = _mm_loadu_si128((const __m128i*)(row + j));
+        _mm_storeu_si128((__m128i*)(row + j), _mm_min_epi32(r, _mm_add_epi32(k, add)));
+    }
+    minPlusScalar(row + j, rowK + j, dik, count - j);
+}
+
+FW_TARGET("avx2")
+static void minPlusAVX2(int* row, const int* rowK, int dik, int count) {
+    __m256i add = _mm256_set1_epi32(dik);
+    int j = 0;
+    for (; j + 8 <= count; j += 8) {
+        __m256i k = _mm256_loadu_si256((const __m256i*)(rowK + j));
+        __m256i r = _mm256_loadu_si256((const __m256i*)(row + j));
+        _mm256_storeu_si256((__m256i*)(row + j), _mm256_min_epi32(r, _mm256_add_epi32(k, add)));
+    }
+    minPlusScalar(row + j, rowK + j, dik, count - j);
+}
+#endif
+
+MinPlusKernel bestMinPlusKernel() {
+#if defined(FW_X86_SIMD) && defined(__GNUC__)
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) return MinPlusKernel::AVX2;
+    if (__builtin_cpu_supports("sse4.1")) return MinPlusKernel::SSE41;
+#elif defined(FW_X86_SIMD)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+    __cpuid(info, 1);
+    bool sse41 = (info[2] & (1 << 19)) != 0;
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    if (maxLeaf >= 7 && osxsave && (_xgetbv(0) & 6) == 6) {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5)) return MinPlusKernel::AVX2;
+    }
+    if (sse41) return MinPlusKernel::SSE41;
+#endif
+    return MinPlusKernel::Scalar;
+}
+
+const char* minPlusKernelName(MinPlusKernel kernel) {
+    switch (kernel) {
+        case MinPlusKernel::AVX2: return "AVX2";
+        case MinPlusKernel::SSE41: return "SSE4.1";
+        default: return "escalar";
+    }
+}
+
+static MinPlusFn kernelFunction(MinPlusKernel kernel) {
+#ifdef FW_X86_SIMD
+    if (kernel == MinPlusKernel::AVX2) return minPlusAVX2;
+    if (kernel == MinPlusKernel::SSE41) return minPlusSSE41;
+#endif
+    (void)kernel;
+    return minPlusScalar;
+}
+
+// ================= Floyd-Warshall =================
+
+// Rows with dik == inf are skipped, and every entry is <= inf, so a sum
+// through k stays below 2 * inf (no overflow while inf <= INT_MAX / 2). With
+// dik >= 0 a sum of inf or more never beats the entry it is compared with,
+// which is itself <= inf: "no path" stays exactly inf and every shorter
+// distance is exact. A negative dik could pull inf + dik under inf, so those
+// rows go through minPlusNegative, which skips the inf entries.
+static void minPlusNegative(int* row, const int* rowK, int dik, int inf, int count) {
+    for (int j = 0; j < count; ++j) {
+        if (rowK[j] < inf && dik + rowK[j] < row[j]) row[j] = dik + rowK[j];
+    }
+}
+
+void floydWarshallNaive(int** dist, int n, int inf) {
+    assert(inf <= INT_MAX / 2);
+    for (int k = 0; k < n; ++k) {
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                if (dist[i][k] < inf && dist[k][j] < inf) {
+                    if (dist[i][k] + dist[k][j] < dist[i][j]) {
+                        dist[i][j] = dist[i][k] + dist[k][j];
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Relax tile rows [i0,i1) x cols [j0,j1) through every k in [k0,k1).
+// k outermost: needed when the tile reads rows/cols it is updating itself.
+static void relaxTileKOuter(int** dist, int i0, int i1, int j0, int j1, int k0, int k1,
+                            int inf, MinPlusFn minPlus) {
+    for (int k = k0; k < k1; ++k) {
+        const int* rowK = dist[k] + j0;
+        for (int i = i0; i < i1; ++i) {
+            int dik = dist[i][k];
+            if (dik >= inf) continue;
+            if (dik < 0) minPlusNegative(dist[i] + j0, rowK, dik, inf, j1 - j0);
+            else minPlus(dist[i] + j0, rowK, dik, j1 - j0);
+        }
+    }
+}
+
+// Same update when the k-row/k-column tiles are final for this round, so row
+// i can stay hot in L1 while all of k runs over it
+static void relaxTileIOuter(int** dist, int i0, int i1, int j0, int j1, int k0, int k1,
+                            int inf, MinPlusFn minPlus) {
+    for (int i = i0; i < i1; ++i) {
+        int* row = dist[i] + j0;
+        for (int k = k0; k < k1; ++k) {
+            int dik = dist[i][k];
+            if (dik >= inf) continue;
+            if (dik < 0) minPlusNegative(row, dist[k] + j0, dik, inf, j1 - j0);
+            else minPlus(row, dist[k] + j0, dik, j1 - j0);
+        }
+    }
+}
+
+void floydWarshallBlocked(int** dist, int n, int inf, MinPlusKernel kernel, ThreadPool* pool) {
+    assert(inf <= INT_MAX / 2);
+    MinPlusFn minPlus = kernelFunction(kernel);
+    int blocks = (n + kTile - 1) / kTile;
+    auto blockEnd = [n](int b) { return (b + 1) * kTile < n ? (b + 1) * kTile : n; };
+
+    for (int kb = 0; kb < blocks; ++kb) {
+        int k0 = kb * kTile;
+        int k1 = blockEnd(kb);
+
+        // Phase 1: the diagonal tile on its own
+        relaxTileKOuter(dist, k0, k1, k0, k1, k0, k1, inf, minPlus);
+
+        // Phase 2: the rest of row block kb and column block kb. Tile pairs
+        // for different b touch disjoint memory.
+        auto phase2 = [&](int b, int) {
+            if (b == kb) return;
+            int b0 = b * kTile;
+            int b1 = blockEnd(b);
+            relaxTileKOuter(dist, k0, k1, b0, b1, k0, k1, inf, minPlus);
+            relaxTileKOuter(dist, b0, b1, k0, k1, k0, k1, inf, minPlus);
+        };
+
+        // Phase 3: every other tile only reads the two finished ones
+        auto phase3 = [&](int t, int) {
+            int ib = t / blocks;
+            int jb = t % blocks;
+            if (ib == kb || jb == kb) return;
+            relaxTileIOuter(dist, ib * kTile, blockEnd(ib), jb * kTile, blockEnd(jb),
+                            k0, k1, inf, minPlus);
+        };
+
+        if (pool) {
+            pool->parallelFor(0, blocks, 1, phase2);
+            pool->parallelFor(0, blocks * blocks, 1, phase3);
+        } else {
+            for (int b = 0; b < blocks; ++b) phase2(b, 0);
+            for (int t = 0; t < blocks * blocks; ++t) phase3(t, 0);
+        }
+    }
+}
@@ -1,17 +1,21 @@
 #include "Graph.h"
 #include <iostream>
+#include <type_traits>
+
+// Graph::clear drops the edge pool without visiting the edges
+static_assert(std::is_trivially_destructible<Edge>::value, "Edge must stay trivially destructible");
 
 // Vertex Implementation
-Vertex::Vertex(int id, std::string label, int x, int y) 
-    : id(id), label(label), x(x), y(y) {}
+Vertex::Vertex(int id, std::string label, int x, int y, ObjectPool<EdgeList::Chunk>* edgeChunks)
+    : id(id), label(label), x(x), y(y), edges(edgeChunks), incoming(edgeChunks), listPos{nullptr, 0} {}
 
 // Edge Implementation
 Edge::Edge(Vertex* src, Vertex* dst, int w) 
-    : source(src), dest(dst), weight(w) {}
+    : source(src), dest(dst), weight(w), isDirected(true), outPos{nullptr, 0}, inPos{nullptr, 0}, twin(nullptr) {}
 
 // Graph Implementation
 Graph::Graph(bool directed, bool weighted) 
-    : directed(directed), weighted(weighted) {}
+    : vertices(&vertexChunkPool), edgeTotal(0), directed(directed), weighted(weighted) {}
 
 Graph::~Graph() {
     clear();
@@ -19,114 +23,139 @@ Graph::~Graph() {
 
 Vertex* Graph::addVertex(int id, const std::string& label, int x, int y) {
     // Check if ID exists
-    for (auto v : vertices) {
-        if (v->id == id) return nullptr;
-    }
-    Vertex* newVertex = new Vertex(id, label, x, y);
-    vertices.push_back(newVertex);
+    if (index.contains(id)) return nullptr;
+    Vertex* newVertex = vertexPool.create(id, label, x, y, &edgeChunkPool);
+    newVertex->listPos = vertices.push_back(newVertex);
+    index.insert(id, newVertex);
     return newVertex;
 }
 
 Vertex* Graph::getVertex(int id) {
-    for (auto v : vertices) {
-        if (v->id == id) return v;
+    Vertex** found = index.find(id);
+    return found ? *found : nullptr;
+}
+
+Edge* Graph::getEdge(int srcId, int destId) {
+    Vertex* src = getVertex(srcId);
+    Vertex* dest = getVertex(destId);
+    if (!src || !dest) return nullptr;
+    for (auto e : src->edges) {
+        if (e->dest == dest) return e;
     }
     return nullptr;
 }
 
+// Creates the edge and records its handles in both lists
+Edge* Graph::linkEdge(Vertex* src, Vertex* dest, int weight) {
+    Edge* e = edgePool.create(src, dest, weight);
+    e->isDirected = directed;
+    e->outPos = src->edges.push_back(e);
+    e->inPos = dest->incoming.push_back(e);
+    edgeTotal++;
+    return e;
+}
+
+void Graph::unlinkEdge(Edge* e) {
+    e->source->edges.erase(e->outPos);
+    e->dest->incoming.erase(e->inPos);
+    edgePool.destroy(e);
+    edgeTotal--;
+}
+
 bool Graph::addEdge(int srcId, int destId, int weight) {
-    Vertex* src = getVertex(srcId);
-    Vertex* dest = getVertex(destId);
+    return addEdge(getVertex(srcId), getVertex(destId), weight) != nullptr;
+}
 
-    if (!src || !dest) return false;
+Edge* Graph::addEdge(Vertex* src, Vertex* dest, int weight) {
+    if (!src || !dest) return nullptr;
 
     // Check if edge already exists
     for (auto e : src->edges) {
-        if (e->dest == dest) return false; 
+        if (e->dest == dest) return nullptr; 
     }
 
-    Edge* newEdge = new Edge(src, dest, weight);
-    src->edges.push_back(newEdge);
+    return appendEdge(src, dest, weight);
+}
+
+Edge* Graph::appendEdge(Vertex* src, Vertex* dest, int weight) {
+    Edge* newEdge = linkEdge(src, dest, weight);
 
     if (!directed) {
         // For undirected, add reverse edge (usually with same weight)
-        Edge* reverseEdge = new Edge(dest, src, weight);
-        dest->edges.push_back(reverseEdge);
+        Edge* reverseEdge = linkEdge(dest, src, weight);
+        newEdge->twin = reverseEdge;
+        reverseEdge->twin = newEdge;
     }
+    return newEdge;
+}
 
-    return true;
+void Graph::reserve(int vertexCount) {
+    if (vertexCount > 0) index.reserve(vertexCount);
 }
 
 bool Graph::removeVertex(int id) {
     Vertex* vToRemove = getVertex(id);
     if (!vToRemove) return false;
 
-    // Remove all edges pointing to this vertex from other vertices
-    for (auto v : vertices) {
-        // We need a robust way to remove while iterating or multiple passes.
-        // Let's use a collection of edges to remove.
-        LinkedList<Edge*> toDelete;
-        for (auto e : v->edges) {
-            if (e->dest == vToRemove) {
-                toDelete.push_back(e);
-            }
-        }
-        
-        for (auto e : toDelete) {
-            v->edges.remove(e);
-            delete e;
-        }
+    // In-edges leave the adjacency list of their source, out-edges the
+    // incoming list of their target: O(degree), no scan of the graph.
+    // Self loops are in both lists of this vertex; they are skipped in the
+    // first pass and freed in the second (a freed edge can't be read again).
+    for (auto e : vToRemove->incoming) {
+        if (e->source == vToRemove) continue;
+        e->source->edges.erase(e->outPos);
+        edgePool.destroy(e);
+        edgeTotal--;
     }
-
-    // Remove edges originating from this vertex
     for (auto e : vToRemove->edges) {
-        delete e;
+        if (e->dest != vToRemove) e->dest->incoming.erase(e->inPos);
+        edgePool.destroy(e);
+        edgeTotal--;
     }
-    vToRemove->edges.clear();
 
-    // Finally remove vertex from graph list
-    vertices.remove(vToRemove);
-    delete vToRemove;
+    vertices.erase(vToRemove->listPos);
+    index.remove(id);
+    vertexPool.destroy(vToRemove);
     return true;
 }
 
-bool Graph::removeEdge(int srcId, int destId) {
-    Vertex* src = getVertex(srcId);
-    Vertex* dest = getVertex(destId);
-
-    if (!src || !dest) return false;
-
-    auto removeSingleEdge = [&](Vertex* from, Vertex* to) {
-        for (auto e : from->edges) {
-            if (e->dest == to) {
-                from->edges.remove(e);
-                delete e;
-                return true;
-            }
-        }
-        return false;
-    };
+bool Graph::removeEdge(Edge* edge) {
+    if (!edge) return false;
+    Edge* twin = edge->twin;
+    unlinkEdge(edge);
+    if (twin) unlinkEdge(twin);
+    return true;
+}
 
-    bool removed = removeSingleEdge(src, dest);
-    if (!directed) {
-        removeSingleEdge(dest, src);
-    }
-    
-    return removed;
+bool Graph::removeEdge(int srcId, int destId) {
+    Edge* e = getEdge(srcId, destId);
+    if (!e) return false;
+    return removeEdge(e);
 }
 
-LinkedList<Vertex*>& Graph::getVertices() {
+VertexList& Graph::getVertices() {
     return vertices;
 }
 
+size_t Graph::edgeCount() const {
+    return edgeTotal;
+}
+
 void Graph::clear() {
+    // Only the labels need a destructor; every chunk, Vertex and Edge goes
+    // back with its pool in one sweep
     for (auto v : vertices) {
-        for (auto e : v->edges) {
-            delete e;
-        }
-        delete v;
+        v->edges.forgetNodes();
+        v->incoming.forgetNodes();
+        v->~Vertex();
     }
-    vertices.clear();
+    vertices.forgetNodes();
+    edgeChunkPool.releaseAll();
+    vertexChunkPool.releaseAll();
+    edgePool.releaseAll();
+    vertexPool.releaseAll();
+    index.clear();
+    edgeTotal = 0;
 }
 
 bool Graph::isDirected() const { return directed; }
@@ -1,392 +1,976 @@
 #include "GraphAlgorithms.h"
+#include "CompactGraph.h"
+#include "IndexedMinHeap.h"
+#include "FloydWarshall.h"
+#include "ThreadPool.h"
+#include "UnionFind.h"
 #include <iostream>
+#include <cmath>
+#include <algorithm>
+
+const int INF = GraphAlgorithms::INF;
+
+// All algorithms run on a CompactGraph snapshot: dense 0..N-1 indices and
+// contiguous edge arrays instead of Vertex*/LinkedList pointer chasing.
+
+// Iterative Tarjan: comp[v] receives the component of every vertex, numbered
+// in reverse topological order (a component only reaches lower numbers).
+// Explicit frame stack, so deep graphs can't overflow the call stack.
+// Returns the number of components.
+static int tarjanComponents(const CompactGraph& cg, int* comp) {
+    int size = cg.vertexCount();
+    const int* offsets = cg.offsetArray();
+    const int* targets = cg.targetArray();
+
+    int* order = new int[size];     // discovery index, -1 = unvisited
+    int* low = new int[size];
+    bool* onStack = new bool[size];
+    int* sccStack = new int[size];
+    int* frameVertex = new int[size];
+    int* frameSlot = new int[size]; // next edge slot to look at
+    for (int i = 0; i < size; ++i) {
+        order[i] = -1;
+        onStack[i] = false;
+    }
 
-const int INF = 1e9;
+    int counter = 0;
+    int components = 0;
+    int sccTop = 0;
+    for (int root = 0; root < size; ++root) {
+        if (order[root] != -1) continue;
+
+        int frames = 0;
+        frameVertex[frames] = root;
+        frameSlot[frames++] = offsets[root];
+        order[root] = low[root] = counter++;
+        sccStack[sccTop++] = root;
+        onStack[root] = true;
+
+        while (frames > 0) {
+            int v = frameVertex[frames - 1];
+            int s = frameSlot[frames - 1];
+            if (s < offsets[v + 1]) {
+                frameSlot[frames - 1]++;
+                int w = targets[s];
+                if (order[w] == -1) {
+                    order[w] = low[w] = counter++;
+                    sccStack[sccTop++] = w;
+                    onStack[w] = true;
+                    frameVertex[frames] = w;
+                    frameSlot[frames++] = offsets[w];
+                } else if (onStack[w] && order[w] < low[v]) {
+                    low[v] = order[w];
+                }
+                continue;
+            }
 
-// Helper to map IDs to 0..N-1 indices
-void mapIdsToIndices(Graph* graph, int*& idMap, int& size) {
-    size = graph->getVertices().size();
-    idMap = new int[size];
-    int i = 0;
-    for (auto v : graph->getVertices()) {
-        idMap[i++] = v->id;
+            // All edges of v done
+            frames--;
+            if (low[v] == order[v]) {
+                int w;
+                do {
+                    w = sccStack[--sccTop];
+                    onStack[w] = false;
+                    comp[w] = components;
+                } while (w != v);
+                components++;
+            }
+            if (frames > 0) {
+                int parent = frameVertex[frames - 1];
+                if (low[v] < low[parent]) low[parent] = low[v];
+            }
+        }
     }
-}
 
-int getIndex(int id, int* idMap, int size) {
-    for (int i = 0; i < size; ++i) {
-        if (idMap[i] == id) return i;
-    }
-    return -1;
+    delete[] order;
+    delete[] low;
+    delete[] onStack;
+    delete[] sccStack;
+    delete[] frameVertex;
+    delete[] frameSlot;
+    return components;
 }
 
-bool** GraphAlgorithms::getPathMatrix(Graph* graph, int& size) {
-    int* idMap;
-    mapIdsToIndices(graph, idMap, size);
-
-    // Allocate matrix
-    bool** matrix = new bool*[size];
+// Warshall on bitset rows: if i reaches k, i reaches everything k reaches
+static void closureWarshall(const CompactGraph& cg, BitMatrix& matrix) {
+    int size = cg.vertexCount();
     for (int i = 0; i < size; ++i) {
-        matrix[i] = new bool[size];
-        for (int j = 0; j < size; ++j) {
-            matrix[i][j] = false;
+        for (int s = cg.edgeBegin(i); s < cg.edgeEnd(i); ++s) {
+            matrix.set(i, cg.target(s));
         }
     }
-
-    // Initialize with direct edges
-    int i = 0;
-    for (auto v : graph->getVertices()) {
-        for (auto e : v->edges) {
-            int j = getIndex(e->dest->id, idMap, size);
-            if (j != -1) matrix[i][j] = true;
+    for (int k = 0; k < size; ++k) {
+        for (int i = 0; i < size; ++i) {
+            if (matrix.get(i, k)) matrix.orRow(i, k);
         }
-        i++;
     }
+}
 
-    // Warshall's Algorithm for transitive closure
-    for (int k = 0; k < size; ++k) {
-        for (int i = 0; i < size; ++i) {
-            for (int j = 0; j < size; ++j) {
-                matrix[i][j] = matrix[i][j] || (matrix[i][k] && matrix[k][j]);
+// Closure through the condensation DAG. Components come out of Tarjan sinks
+// first, so each one only ORs rows that are already complete. A component's
+// row is built once on its first member and copied to the others.
+static void closureCondensed(const CompactGraph& cg, BitMatrix& matrix) {
+    int size = cg.vertexCount();
+    int* comp = new int[size];
+    int components = tarjanComponents(cg, comp);
+
+    // Members of each component (counting sort by component)
+    int* start = new int[components + 1];
+    int* members = new int[size];
+    for (int c = 0; c <= components; ++c) start[c] = 0;
+    for (int v = 0; v < size; ++v) start[comp[v] + 1]++;
+    for (int c = 0; c < components; ++c) start[c + 1] += start[c];
+    int* fill = new int[components];
+    for (int c = 0; c < components; ++c) fill[c] = start[c];
+    for (int v = 0; v < size; ++v) members[fill[comp[v]]++] = v;
+
+    for (int c = 0; c < components; ++c) {
+        int rep = members[start[c]];
+        bool cyclic = (start[c + 1] - start[c]) > 1;
+        for (int m = start[c]; m < start[c + 1]; ++m) {
+            int u = members[m];
+            for (int s = cg.edgeBegin(u); s < cg.edgeEnd(u); ++s) {
+                int d = comp[cg.target(s)];
+                if (d == c) {
+                    cyclic = true; // self loop or edge inside the component
+                    continue;
+                }
+                // Reaching component d means reaching its members and all they reach
+                matrix.orRow(rep, members[start[d]]);
+                for (int k = start[d]; k < start[d + 1]; ++k) matrix.set(rep, members[k]);
             }
         }
+        if (cyclic) {
+            for (int k = start[c]; k < start[c + 1]; ++k) matrix.set(rep, members[k]);
+        }
+        for (int m = start[c] + 1; m < start[c + 1]; ++m) {
+            matrix.copyRow(members[m], rep);
+        }
     }
 
-    delete[] idMap;
-    return matrix;
+    delete[] comp;
+    delete[] start;
+    delete[] members;
+    delete[] fill;
 }
 
-LinkedList<Edge*> GraphAlgorithms::getShortestPathDijkstra(Graph* graph, int startId, int endId) {
-    LinkedList<Edge*> path;
-    int size = graph->getVertices().size();
-    if (size == 0) return path;
+BitMatrix* GraphAlgorithms::getPathMatrix(Graph* graph, int& size, ClosureMode mode) {
+    CompactGraph cg(graph);
+    size = cg.vertexCount();
+    BitMatrix* matrix = new BitMatrix(size);
 
-    // We need a way to map Vertex* to dist/pred
-    // Since we can't use map/vector, we can add temp properties to Vertex? 
-    // Or use parallel arrays if we map to indices.
-    
-    int* idMap;
-    int realSize;
-    mapIdsToIndices(graph, idMap, realSize);
-    
-    int startIdx = getIndex(startId, idMap, realSize);
-    int endIdx = getIndex(endId, idMap, realSize);
-
-    if (startIdx == -1 || endIdx == -1) {
-        delete[] idMap;
-        return path;
+    if (mode == ClosureMode::Auto) {
+        // Dense graphs tend to be one big component: nothing to condense
+        mode = cg.edgeCount() < (long long)size * 64 ? ClosureMode::Condensed : ClosureMode::Warshall;
     }
+    if (mode == ClosureMode::Condensed) closureCondensed(cg, *matrix);
+    else closureWarshall(cg, *matrix);
 
-    int* dist = new int[realSize];
-    int* pred = new int[realSize]; // Predecessor index
-    bool* visited = new bool[realSize];
+    return matrix;
+}
+
+// Heap-based Dijkstra on the snapshot. Fills dist/pred/predEdge for every
+// settled vertex; stops early once `target` is settled (-1 = run to the end).
+// `done` is scratch space of vertexCount() flags. Settled vertices are never
+// reopened, so negative weights can't make it loop (same as the old version).
+// Returns the number of settled vertices.
+static int dijkstraSearch(const CompactGraph& cg, int source, int target,
+                          int* dist, int* pred, Edge** predEdge, bool* done,
+                          IndexedMinHeap<int>& heap) {
+    int size = cg.vertexCount();
+    const int* offsets = cg.offsetArray();
+    const int* targets = cg.targetArray();
+    const int* weights = cg.weightArray();
 
-    for (int i = 0; i < realSize; ++i) {
+    for (int i = 0; i < size; ++i) {
         dist[i] = INF;
         pred[i] = -1;
-        visited[i] = false;
+        predEdge[i] = nullptr;
+        done[i] = false;
     }
+    heap.clear();
 
-    dist[startIdx] = 0;
+    dist[source] = 0;
+    heap.push(source, 0);
+    int settled = 0;
 
-    for (int i = 0; i < realSize; ++i) {
-        // Find min dist node not visited
-        int u = -1;
-        int minVal = INF;
-        for (int j = 0; j < realSize; ++j) {
-            if (!visited[j] && dist[j] < minVal) {
-                minVal = dist[j];
-                u = j;
+    while (!heap.isEmpty()) {
+        int u = heap.pop();
+        done[u] = true;
+        settled++;
+        if (u == target) break; // Reached target
+
+        // Relax edges
+        int du = dist[u];
+        for (int s = offsets[u]; s < offsets[u + 1]; ++s) {
+            int v = targets[s];
+            if (done[v]) continue;
+            long long candidate = (long long)du + weights[s];
+            if (candidate < dist[v]) {
+                dist[v] = (int)candidate;
+                pred[v] = u;
+                predEdge[v] = cg.edgeAt(s);
+                heap.pushOrDecrease(v, dist[v]);
             }
         }
+    }
+    return settled;
+}
 
-        if (u == -1 || dist[u] == INF) break;
-        visited[u] = true;
+// Walk predecessors back from `target` and append the edges Start -> End
+static void buildPath(int source, int target, const int* pred, Edge* const* predEdge,
+                      LinkedList<Edge*>& path) {
+    if (target == source || predEdge[target] == nullptr) return;
+
+    // pred gives End -> Start, so count the hops and fill an array backwards
+    int pathCount = 0;
+    for (int curr = target; curr != source; curr = pred[curr]) pathCount++;
+    Edge** temp = new Edge*[pathCount];
+    int k = pathCount;
+    for (int curr = target; curr != source; curr = pred[curr]) {
+        temp[--k] = predEdge[curr];
+    }
+    for (int j = 0; j < pathCount; ++j) {
+        path.push_back(temp[j]);
+    }
+    delete[] temp;
+}
 
-        if (u == endIdx) break; // Reached target
+LinkedList<Edge*> GraphAlgorithms::getShortestPathDijkstra(Graph* graph, int startId, int endId, int* settledCount) {
+    CompactGraph cg(graph);
+    return getShortestPathDijkstra(cg, startId, endId, settledCount);
+}
 
-        // Relax edges
-        Vertex* uVertex = graph->getVertex(idMap[u]);
-        for (auto e : uVertex->edges) {
-            int v = getIndex(e->dest->id, idMap, realSize);
-            if (v != -1 && !visited[v]) {
-                if (dist[u] + e->weight < dist[v]) {
-                    dist[v] = dist[u] + e->weight;
+LinkedList<Edge*> GraphAlgorithms::getShortestPathDijkstra(const CompactGraph& cg, int startId, int endId, int* settledCount) {
+    LinkedList<Edge*> path;
+    int size = cg.vertexCount();
+    if (size == 0) return path;
+
+    int startIdx = cg.indexOf(startId);
+    int endIdx = cg.indexOf(endId);
+    if (startIdx == -1 || endIdx == -1) return path;
+
+    int* dist = new int[size];
+    int* pred = new int[size];
+    Edge** predEdge = new Edge*[size];
+    bool* done = new bool[size];
+    IndexedMinHeap<int> heap(size);
+
+    int settled = dijkstraSearch(cg, startIdx, endIdx, dist, pred, predEdge, done, heap);
+    if (settledCount) *settledCount = settled;
+    buildPath(startIdx, endIdx, pred, predEdge, path);
+
+    delete[] dist;
+    delete[] pred;
+    delete[] predEdge;
+    delete[] done;
+    return path;
+}
+
+LinkedList<Edge*> GraphAlgorithms::getShortestPathBidirectional(Graph* graph, int startId, int endId, int* settledCount) {
+    CompactGraph cg(graph, true);
+    return getShortestPathBidirectional(cg, startId, endId, settledCount);
+}
+
+LinkedList<Edge*> GraphAlgorithms::getShortestPathBidirectional(const CompactGraph& cg, int startId, int endId, int* settledCount) {
+    if (!cg.hasReverse()) return getShortestPathDijkstra(cg, startId, endId, settledCount);
+
+    LinkedList<Edge*> path;
+    if (settledCount) *settledCount = 0;
+    int size = cg.vertexCount();
+    int s = cg.indexOf(startId);
+    int t = cg.indexOf(endId);
+    if (s == -1 || t == -1) return path;
+    if (s == t) {
+        if (settledCount) *settledCount = 1;
+        return path;
+    }
+
+    const int* offsets = cg.offsetArray();
+    const int* targets = cg.targetArray();
+    const int* weights = cg.weightArray();
+    const int* rOffsets = cg.reverseOffsetArray();
+    const int* rSources = cg.reverseSourceArray();
+    const int* rWeights = cg.reverseWeightArray();
+    const int* rSlots = cg.reverseSlotArray();
+
+    // Forward search keeps pred/predEdge toward s, backward search keeps
+    // succ/succEdge toward t (succEdge is the forward edge v -> succ[v])
+    int* distF = new int[size];
+    int* distB = new int[size];
+    int* pred = new int[size];
+    int* succ = new int[size];
+    Edge** predEdge = new Edge*[size];
+    Edge** succEdge = new Edge*[size];
+    bool* doneF = new bool[size];
+    bool* doneB = new bool[size];
+    for (int i = 0; i < size; ++i) {
+        distF[i] = distB[i] = INF;
+        pred[i] = succ[i] = -1;
+        predEdge[i] = succEdge[i] = nullptr;
+        doneF[i] = doneB[i] = false;
+    }
+    IndexedMinHeap<int> heapF(size);
+    IndexedMinHeap<int> heapB(size);
+
+    distF[s] = 0;
+    distB[t] = 0;
+    heapF.push(s, 0);
+    heapB.push(t, 0);
+
+    long long best = INF; // length of the best s-t path seen so far
+    int meet = -1;
+    int settled = 0;
+
+    while (!heapF.isEmpty() && !heapB.isEmpty()) {
+        // Once the two frontiers together can't beat `best`, it is optimal
+        if ((long long)heapF.topPriority() + heapB.topPriority() >= best) break;
+
+        if (heapF.size() <= heapB.size()) {
+            int u = heapF.pop();
+            doneF[u] = true;
+            settled++;
+            for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+                int v = targets[e];
+                if (doneF[v]) continue;
+                long long candidate = (long long)distF[u] + weights[e];
+                if (candidate < distF[v]) {
+                    distF[v] = (int)candidate;
                     pred[v] = u;
+                    predEdge[v] = cg.edgeAt(e);
+                    heapF.pushOrDecrease(v, distF[v]);
+                }
+                if (distB[v] < INF && candidate + distB[v] < best) {
+                    best = candidate + distB[v];
+                    meet = v;
                 }
             }
-        }
-    }
-
-    // Reconstruct path
-    if (dist[endIdx] != INF) {
-        int curr = endIdx;
-        while (curr != -1 && curr != startIdx) {
-            int prev = pred[curr];
-            if (prev != -1) {
-                Vertex* uVertex = graph->getVertex(idMap[prev]);
-                Vertex* vVertex = graph->getVertex(idMap[curr]);
-                // Find edge
-                for (auto e : uVertex->edges) {
-                    if (e->dest == vVertex) {
-                        // Ideally we should pick the specific edge with min weight if multi-graph, 
-                        // but here we just take the first one or check weight? 
-                        // Dijkstra guarantees we used *an* edge. 
-                        // Actually we should store the Edge* in pred but we stored index.
-                        // Let's just find the edge that matches the weight logic or just the connection.
-                        if (dist[prev] + e->weight == dist[curr]) {
-                             path.push_back(e);
-                             break;
-                        }
-                    }
+        } else {
+            int u = heapB.pop();
+            doneB[u] = true;
+            settled++;
+            for (int r = rOffsets[u]; r < rOffsets[u + 1]; ++r) {
+                int v = rSources[r];
+                if (doneB[v]) continue;
+                long long candidate = (long long)distB[u] + rWeights[r];
+                if (candidate < distB[v]) {
+                    distB[v] = (int)candidate;
+                    succ[v] = u;
+                    succEdge[v] = cg.edgeAt(rSlots[r]);
+                    heapB.pushOrDecrease(v, distB[v]);
+                }
+                if (distF[v] < INF && candidate + distF[v] < best) {
+                    best = candidate + distF[v];
+                    meet = v;
                 }
             }
-            curr = prev;
         }
     }
-    
-    // Path is currently reversed (End -> Start). We might want to reverse it or let the GUI handle it.
-    // LinkedList doesn't have reverse easily.
-    // Let's create a new list in correct order.
-    // Wait, simple usage of LinkedList means simple push_back. 
-    // To reverse, we can just push to a new list or iterate backwards if it was distinct nodes.
-    // Since we need to draw it, order matters for animation/drawing direction? 
-    // For now, let's keep it reversed or fix it. A simple fix is to use a stack or just creating a new list.
-    
-    LinkedList<Edge*> correctOrderPath;
-    // ... manual reverse ... but for now, let's just return it. 
-    // Actually, let's fix it.
-    // LinkedList doesn't have random access.
-    // Let's re-build it? No.
-    // We can rely on the fact it's doubly linked. Use tail and iterate back?
-    // Oh, my LinkedList has `tail`. I can iterate reverse if I added `rbegin`?
-    // I didn't add iterators for reverse.
-    
-    // Quick fix: Use a temporary array of Edge* then push_back to new list.
-    int pathCount = path.size();
-    if (pathCount > 0) {
-        Edge** temp = new Edge*[pathCount];
-        int k = 0;
-        for (auto e : path) {
-            temp[k++] = e;
+
+    if (meet != -1) {
+        buildPath(s, meet, pred, predEdge, path);
+        for (int curr = meet; curr != t; curr = succ[curr]) {
+            path.push_back(succEdge[curr]);
         }
-        for (int j = pathCount - 1; j >= 0; --j) {
-            correctOrderPath.push_back(temp[j]);
+    }
+    if (settledCount) *settledCount = settled;
+
+    delete[] distF;
+    delete[] distB;
+    delete[] pred;
+    delete[] succ;
+    delete[] predEdge;
+    delete[] succEdge;
+    delete[] doneF;
+    delete[] doneB;
+    return path;
+}
+
+LinkedList<Edge*> GraphAlgorithms::getShortestPathAStar(Graph* graph, int startId, int endId, int* settledCount) {
+    CompactGraph cg(graph);
+    return getShortestPathAStar(cg, startId, endId, settledCount);
+}
+
+LinkedList<Edge*> GraphAlgorithms::getShortestPathAStar(const CompactGraph& cg, int startId, int endId, int* settledCount) {
+    LinkedList<Edge*> path;
+    if (settledCount) *settledCount = 0;
+    int size = cg.vertexCount();
+    int s = cg.indexOf(startId);
+    int t = cg.indexOf(endId);
+    if (s == -1 || t == -1) return path;
+
+    const int* offsets = cg.offsetArray();
+    const int* targets = cg.targetArray();
+    const int* weights = cg.weightArray();
+
+    // Weights are not tied to the drawing, so scale the straight-line distance
+    // by the smallest weight/length ratio. Then h(u) <= w(u,v) + h(v) for every
+    // edge (consistent heuristic). Any negative weight disables it (scale 0).
+    double scale = cg.minWeightPerLength();
+    scale *= 1 - 1e-9; // keep rounding from making h overestimate
+    double tx = cg.xAt(t);
+    double ty = cg.yAt(t);
+    auto heuristic = [&](int v) {
+        double dx = cg.xAt(v) - tx;
+        double dy = cg.yAt(v) - ty;
+        return scale * std::sqrt(dx * dx + dy * dy);
+    };
+
+    int* dist = new int[size];
+    int* pred = new int[size];
+    Edge** predEdge = new Edge*[size];
+    bool* done = new bool[size];
+    for (int i = 0; i < size; ++i) {
+        dist[i] = INF;
+        pred[i] = -1;
+        predEdge[i] = nullptr;
+        done[i] = false;
+    }
+    IndexedMinHeap<double> heap(size);
+
+    dist[s] = 0;
+    heap.push(s, heuristic(s));
+    int settled = 0;
+
+    while (!heap.isEmpty()) {
+        int u = heap.pop();
+        done[u] = true;
+        settled++;
+        if (u == t) break;
+
+        for (int e = offsets[u]; e < offsets[u + 1]; ++e) {
+            int v = targets[e];
+            if (done[v]) continue;
+            long long candidate = (long long)dist[u] + weights[e];
+            if (candidate < dist[v]) {
+                dist[v] = (int)candidate;
+                pred[v] = u;
+                predEdge[v] = cg.edgeAt(e);
+                heap.pushOrDecrease(v, dist[v] + heuristic(v));
+            }
         }
-        delete[] temp;
     }
-    
+
+    buildPath(s, t, pred, predEdge, path);
+    if (settledCount) *settledCount = settled;
+
     delete[] dist;
     delete[] pred;
-    delete[] visited;
-    delete[] idMap;
-    return correctOrderPath;
+    delete[] predEdge;
+    delete[] done;
+    return path;
 }
 
-int** GraphAlgorithms::getAllPairsShortestPaths(Graph* graph, int& size, int*& idMap) {
-    mapIdsToIndices(graph, idMap, size);
+ShortestPathTree* GraphAlgorithms::getShortestPathTree(Graph* graph, int startId) {
+    CompactGraph cg(graph);
+    return getShortestPathTree(cg, startId);
+}
+
+ShortestPathTree* GraphAlgorithms::getShortestPathTree(const CompactGraph& cg, int startId) {
+    int size = cg.vertexCount();
+    ShortestPathTree* tree = new ShortestPathTree(size);
 
-    int** dist = new int*[size];
     for (int i = 0; i < size; ++i) {
-        dist[i] = new int[size];
-        for (int j = 0; j < size; ++j) {
-            if (i == j) dist[i][j] = 0;
-            else dist[i][j] = INF;
+        tree->idMap[i] = cg.idAt(i);
+        tree->indexById.insert(cg.idAt(i), i);
+    }
+
+    tree->source = cg.indexOf(startId);
+    if (tree->source == -1) return tree;
+
+    bool* done = new bool[size];
+    IndexedMinHeap<int> heap(size);
+    dijkstraSearch(cg, tree->source, -1, tree->dist, tree->pred, tree->predEdge, done, heap);
+    delete[] done;
+    return tree;
+}
+
+ShortestPathTree::ShortestPathTree(int n) : size(n), source(-1) {
+    idMap = new int[n];
+    dist = new int[n];
+    pred = new int[n];
+    predEdge = new Edge*[n];
+    for (int i = 0; i < n; ++i) {
+        dist[i] = INF;
+        pred[i] = -1;
+        predEdge[i] = nullptr;
+    }
+}
+
+ShortestPathTree::~ShortestPathTree() {
+    delete[] idMap;
+    delete[] dist;
+    delete[] pred;
+    delete[] predEdge;
+}
+
+int ShortestPathTree::indexOf(int id) const {
+    const int* found = indexById.find(id);
+    return found ? *found : -1;
+}
+
+bool ShortestPathTree::reaches(int id) const {
+    int i = indexOf(id);
+    return i != -1 && dist[i] < INF;
+}
+
+LinkedList<Edge*> ShortestPathTree::pathTo(int id) const {
+    LinkedList<Edge*> path;
+    int i = indexOf(id);
+    if (i != -1 && source != -1) buildPath(source, i, pred, predEdge, path);
+    return path;
+}
+
+// Cost of one Dijkstra heap step in Floyd-Warshall min-plus updates, for
+// ApspMode::Auto. Measured on one x86-64 core with AVX2 by GraphBenchmarks:
+// "dijkstra" settles ~300k vertices of the 708x708 grid in ~72 ms, about
+// 3 ns per (E + V) log V step; "floyd" runs N = 2000 (8e9 updates) in
+// ~0.8-1.4 s with AVX2, 0.1-0.17 ns each. Machine-specific: re-run both (and
+// "apsp", which prints where Auto lands) when tuning for other hardware.
+static const double kHeapStepPerMinPlusUpdate = 25.0;
+
+int** GraphAlgorithms::getAllPairsShortestPaths(Graph* graph, int& size, int*& idMap,
+                                                 ApspMode mode, ThreadPool* pool) {
+    CompactGraph cg(graph);
+    size = cg.vertexCount();
+    idMap = cg.copyIdMap();
+    if (!pool) pool = &ThreadPool::global();
+
+    // Dijkstra is wrong with negative weights; Floyd-Warshall handles them
+    bool negative = false;
+    const int* weights = cg.weightArray();
+    for (int s = 0; s < cg.edgeCount() && !negative; ++s) negative = weights[s] < 0;
+
+    if (mode == ApspMode::Auto) {
+        // V Dijkstras cost ~V (E + V) log V heap steps, Floyd-Warshall V^3
+        // min-plus updates
+        double v = size > 1 ? size : 2;
+        double dijkstraCost = v * (cg.edgeCount() + v) * std::log2(v) * kHeapStepPerMinPlusUpdate;
+        double floydCost = v * v * v;
+        mode = dijkstraCost < floydCost ? ApspMode::RepeatedDijkstra : ApspMode::FloydWarshall;
+    }
+    if (negative) mode = ApspMode::FloydWarshall;
+
+    // One contiguous aligned block (see FloydWarshall.h); freeMatrix releases it
+    int** dist = allocDistanceMatrix(size);
+
+    if (mode == ApspMode::RepeatedDijkstra) {
+        // One search per source, each writing its row directly. Scratch is
+        // per worker, so memory stays O(V) per thread besides the result.
+        int workers = pool->threadCount();
+        int** pred = new int*[workers];
+        Edge*** predEdge = new Edge**[workers];
+        bool** done = new bool*[workers];
+        IndexedMinHeap<int>** heaps = new IndexedMinHeap<int>*[workers];
+        for (int w = 0; w < workers; ++w) {
+            pred[w] = new int[size];
+            predEdge[w] = new Edge*[size];
+            done[w] = new bool[size];
+            heaps[w] = new IndexedMinHeap<int>(size);
+        }
+
+        pool->parallelFor(0, size, 1, [&](int source, int w) {
+            dijkstraSearch(cg, source, -1, dist[source], pred[w], predEdge[w], done[w], *heaps[w]);
+        });
+
+        for (int w = 0; w < workers; ++w) {
+            delete[] pred[w];
+            delete[] predEdge[w];
+            delete[] done[w];
+            delete heaps[w];
         }
+        delete[] pred;
+        delete[] predEdge;
+        delete[] done;
+        delete[] heaps;
+        return dist;
     }
 
-    int i = 0;
-    for (auto v : graph->getVertices()) {
-        for (auto e : v->edges) {
-            int j = getIndex(e->dest->id, idMap, size);
-            if (j != -1) {
-                // Handle directed/undirected inside graph, here we just read edges
-                if (e->weight < dist[i][j]) {
-                    dist[i][j] = e->weight;
-                }
-            }
+    for (int i = 0; i < size; ++i) {
+        for (int j = 0; j < size; ++j) {
+            dist[i][j] = INF;
         }
-        i++;
+        dist[i][i] = 0;
     }
 
-    // Floyd-Warshall
-    for (int k = 0; k < size; ++k) {
-        for (int i = 0; i < size; ++i) {
-            for (int j = 0; j < size; ++j) {
-                if (dist[i][k] != INF && dist[k][j] != INF) {
-                    if (dist[i][k] + dist[k][j] < dist[i][j]) {
-                        dist[i][j] = dist[i][k] + dist[k][j];
-                    }
-                }
+    for (int i = 0; i < size; ++i) {
+        for (int s = cg.edgeBegin(i); s < cg.edgeEnd(i); ++s) {
+            int j = cg.target(s);
+            // Handle directed/undirected inside graph, here we just read edges
+            if (cg.weight(s) < dist[i][j]) {
+                dist[i][j] = cg.weight(s);
             }
         }
     }
 
+    // Tiled Floyd-Warshall with the widest min-plus kernel this CPU has,
+    // tiles of each phase spread over the pool
+    static const MinPlusKernel kernel = bestMinPlusKernel();
+    floydWarshallBlocked(dist, size, INF, kernel, pool);
+
     return dist;
 }
 
+// Heap-based Prim, restarted from every vertex not yet in a tree, so a
+// disconnected graph yields a minimum spanning forest. Edge direction is
+// ignored: on directed graphs in-edges are scanned as well, which gives the
+// same forest Kruskal finds.
 LinkedList<Edge*> GraphAlgorithms::getMSTPrim(Graph* graph) {
     LinkedList<Edge*> mst;
-    int size;
-    int* idMap;
-    mapIdsToIndices(graph, idMap, size);
-    
-    if (size == 0) {
-         delete[] idMap; 
-         return mst;
-    }
-
-    bool* visited = new bool[size];
-    for (int i = 0; i < size; ++i) visited[i] = false;
-
-    // Start from first node
-    visited[0] = true;
-    int numEdges = 0;
-
-    // Basic Prim's O(V*E)
-    // Repeat V-1 times
-    while (numEdges < size - 1) {
-        int minWeight = INF;
-        Vertex* startNode = nullptr;
-        Edge* minEdge = nullptr;
-
-        // Iterate all visited nodes
-        int uIdx = 0;
-        for (auto u : graph->getVertices()) {
-            if (visited[uIdx]) { // Only consider edges from visited set
-                 for (auto e : u->edges) {
-                     int vIdx = getIndex(e->dest->id, idMap, size);
-                     if (vIdx != -1 && !visited[vIdx]) { // To unvisited
-                         if (e->weight < minWeight) {
-                             minWeight = e->weight;
-                             minEdge = e; 
-                         }
-                     }
-                 }
+    CompactGraph cg(graph, graph->isDirected());
+    int size = cg.vertexCount();
+    if (size == 0) return mst;
+
+    const int* offsets = cg.offsetArray();
+    const int* targets = cg.targetArray();
+    const int* weights = cg.weightArray();
+    const int* revOffsets = cg.reverseOffsetArray();
+    const int* revSources = cg.reverseSourceArray();
+    const int* revWeights = cg.reverseWeightArray();
+    const int* revSlots = cg.reverseSlotArray();
+
+    bool* inTree = new bool[size];
+    Edge** bestEdge = new Edge*[size]; // cheapest edge linking the vertex to the tree
+    for (int i = 0; i < size; ++i) inTree[i] = false;
+    IndexedMinHeap<int> heap(size);
+
+    for (int root = 0; root < size; ++root) {
+        if (inTree[root]) continue;
+        heap.push(root, 0);
+        bestEdge[root] = nullptr;
+
+        while (!heap.isEmpty()) {
+            int u = heap.pop();
+            inTree[u] = true;
+            if (bestEdge[u]) mst.push_back(bestEdge[u]);
+
+            for (int s = offsets[u]; s < offsets[u + 1]; ++s) {
+                int v = targets[s];
+                if (!inTree[v] && heap.pushOrDecrease(v, weights[s])) bestEdge[v] = cg.edgeAt(s);
+            }
+            if (revOffsets) {
+                for (int r = revOffsets[u]; r < revOffsets[u + 1]; ++r) {
+                    int v = revSources[r];
+                    if (!inTree[v] && heap.pushOrDecrease(v, revWeights[r])) bestEdge[v] = cg.edgeAt(revSlots[r]);
+                }
             }
-            uIdx++;
         }
+    }
 
-        if (minEdge) {
-            mst.push_back(minEdge);
-            // Mark dest as visited
-            int targetIdx = getIndex(minEdge->dest->id, idMap, size);
-            visited[targetIdx] = true;
-            numEdges++;
-        } else {
-            // Disconnected graph or done
-            break;
+    delete[] inTree;
+    delete[] bestEdge;
+    return mst;
+}
+
+// Kruskal: edges by increasing weight, kept when they join two different
+// trees. Also a spanning forest on disconnected graphs, direction ignored.
+LinkedList<Edge*> GraphAlgorithms::getMSTKruskal(Graph* graph) {
+    LinkedList<Edge*> mst;
+    CompactGraph cg(graph);
+    int size = cg.vertexCount();
+    if (size == 0) return mst;
+
+    // Undirected edges are stored in both directions: keep one copy
+    struct WeightedEdge {
+        int weight;
+        int slot;
+        int u;
+        int v;
+    };
+    WeightedEdge* list = new WeightedEdge[cg.edgeCount() > 0 ? cg.edgeCount() : 1];
+    int count = 0;
+    for (int u = 0; u < size; ++u) {
+        for (int s = cg.edgeBegin(u); s < cg.edgeEnd(u); ++s) {
+            int v = cg.target(s);
+            if (v == u) continue;
+            if (!cg.isDirected() && v < u) continue;
+            list[count++] = {cg.weight(s), s, u, v};
         }
     }
+    // Ties broken by slot so the result is deterministic
+    std::sort(list, list + count, [](const WeightedEdge& a, const WeightedEdge& b) {
+        return a.weight < b.weight || (a.weight == b.weight && a.slot < b.slot);
+    });
+
+    UnionFind sets(size);
+    for (int i = 0; i < count && sets.setCount() > 1; ++i) {
+        if (sets.unite(list[i].u, list[i].v)) mst.push_back(cg.edgeAt(list[i].slot));
+    }
 
-    delete[] visited;
-    delete[] idMap;
+    delete[] list;
     return mst;
 }
 
-void GraphAlgorithms::freeMatrix(bool** matrix, int size) {
-    for (int i = 0; i < size; ++i) delete[] matrix[i];
-    delete[] matrix;
+void GraphAlgorithms::freeMatrix(int** matrix, int size) {
+    (void)size; // rows live in one block
+    freeDistanceMatrix(matrix);
 }
+// Iterative DFS (explicit frame stack, so long paths can't overflow the call
+// stack). Vertices are white (0), on the DFS path (1) or finished (2).
+// Returns the slot of the edge that closes a cycle, or -1; parentSlot then
+// holds the tree edge used to reach each vertex on the path.
+static int findCycleSlot(const CompactGraph& cg, int* parentSlot) {
+    int size = cg.vertexCount();
+    const int* offsets = cg.offsetArray();
+    const int* targets = cg.targetArray();
+    bool directed = cg.isDirected();
+
+    unsigned char* color = new unsigned char[size];
+    int* frameVertex = new int[size];
+    int* frameSlot = new int[size];
+    for (int i = 0; i < size; ++i) color[i] = 0;
+
+    int closing = -1;
+    for (int root = 0; root < size && closing == -1; ++root) {
+        if (color[root] != 0) continue;
+        int frames = 0;
+        frameVertex[frames] = root;
+        frameSlot[frames++] = offsets[root];
+        color[root] = 1;
+        parentSlot[root] = -1;
+
+        while (frames > 0 && closing == -1) {
+            int u = frameVertex[frames - 1];
+            int s = frameSlot[frames - 1];
+            if (s == offsets[u + 1]) {
+                color[u] = 2;
+                frames--;
+                continue;
+            }
+            frameSlot[frames - 1]++;
+            int v = targets[s];
+            if (color[v] == 0) {
+                color[v] = 1;
+                parentSlot[v] = s;
+                frameVertex[frames] = v;
+                frameSlot[frames++] = offsets[v];
+            } else if (color[v] == 1) {
+                // Back edge. Undirected graphs store every connection twice,
+                // so the way back to the parent doesn't count (self loops do).
+                bool toParent = !directed && v != u && frames > 1 && frameVertex[frames - 2] == v;
+                if (!toParent) closing = s;
+            }
+        }
+    }
 
-void GraphAlgorithms::freeMatrix(int** matrix, int size) {
-    for (int i = 0; i < size; ++i) delete[] matrix[i];
-    delete[] matrix;
+    delete[] color;
+    delete[] frameVertex;
+    delete[] frameSlot;
+    return closing;
+}
+
+bool GraphAlgorithms::hasCycles(Graph* graph) {
+    CompactGraph cg(graph);
+    int* parentSlot = new int[cg.vertexCount() > 0 ? cg.vertexCount() : 1];
+    bool result = findCycleSlot(cg, parentSlot) != -1;
+    delete[] parentSlot;
+    return result;
 }
-bool hasCyclesRecursive(Graph* graph, int u, bool* visited, bool* recStack, int* idMap, int size) {
-    visited[u] = true;
-    recStack[u] = true;
-
-    Vertex* v = graph->getVertex(idMap[u]);
-    for (auto e : v->edges) {
-        int vIdx = getIndex(e->dest->id, idMap, size);
-        if (vIdx != -1) {
-            if (!visited[vIdx] && hasCyclesRecursive(graph, vIdx, visited, recStack, idMap, size))
-                return true;
-            else if (recStack[vIdx])
-                return true;
+
+LinkedList<Edge*> GraphAlgorithms::findCycle(Graph* graph) {
+    LinkedList<Edge*> cycle;
+    CompactGraph cg(graph);
+    int size = cg.vertexCount();
+    int* parentSlot = new int[size > 0 ? size : 1];
+    int closing = findCycleSlot(cg, parentSlot);
+    if (closing != -1) {
+        // The closing edge goes u -> v with v on the DFS path above u: walk
+        // the tree edges back from u to v, then append the closing edge.
+        int v = cg.target(closing);
+        int count = 0;
+        Edge** reversed = new Edge*[size];
+        int u = cg.indexOf(cg.edgeAt(closing)->source->id);
+        while (u != v) {
+            int s = parentSlot[u];
+            reversed[count++] = cg.edgeAt(s);
+            u = cg.indexOf(cg.edgeAt(s)->source->id);
         }
+        while (count > 0) cycle.push_back(reversed[--count]);
+        cycle.push_back(cg.edgeAt(closing));
+        delete[] reversed;
     }
+    delete[] parentSlot;
+    return cycle;
+}
 
-    recStack[u] = false;
-    return false;
+int* GraphAlgorithms::getStronglyConnectedComponents(Graph* graph, int*& idMap, int& size, int& count) {
+    CompactGraph cg(graph);
+    size = cg.vertexCount();
+    idMap = cg.copyIdMap();
+    int* component = new int[size > 0 ? size : 1];
+    count = tarjanComponents(cg, component);
+    return component;
 }
+// Single-source distances over raw CSR arrays (forward or reverse), BFS hop
+// counts when `weighted` is false. Weights must be non-negative.
+static void distancesFrom(int size, const int* offsets, const int* targets, const int* weights,
+                          bool weighted, int source, int* dist, int* queue, IndexedMinHeap<int>& heap) {
+    for (int i = 0; i < size; ++i) dist[i] = INF;
+    dist[source] = 0;
+
+    if (!weighted) {
+        int head = 0, tail = 0;
+        queue[tail++] = source;
+        while (head < tail) {
+            int u = queue[head++];
+            for (int s = offsets[u]; s < offsets[u + 1]; ++s) {
+                int v = targets[s];
+                if (dist[v] == INF) {
+                    dist[v] = dist[u] + 1;
+                    queue[tail++] = v;
+                }
+            }
+        }
+        return;
+    }
 
-bool hasCyclesUndirected(Graph* graph, int u, bool* visited, int parent, int* idMap, int size) {
-    visited[u] = true;
-
-    Vertex* vText = graph->getVertex(idMap[u]);
-    for (auto e : vText->edges) {
-        int vIdx = getIndex(e->dest->id, idMap, size);
-        if (vIdx != -1) {
-            if (!visited[vIdx]) {
-                if (hasCyclesUndirected(graph, vIdx, visited, u, idMap, size))
-                    return true;
-            } else if (vIdx != parent) {
-                return true;
+    // Lazy "settled" test: a popped vertex's distance is final, and relaxing
+    // it again can't lower anything, so no done[] array is needed
+    heap.clear();
+    heap.push(source, 0);
+    while (!heap.isEmpty()) {
+        int u = heap.pop();
+        int du = dist[u];
+        for (int s = offsets[u]; s < offsets[u + 1]; ++s) {
+            int v = targets[s];
+            long long candidate = (long long)du + weights[s];
+            if (candidate < dist[v]) {
+                dist[v] = (int)candidate;
+                heap.pushOrDecrease(v, dist[v]);
             }
         }
     }
-    return false;
 }
 
-bool GraphAlgorithms::hasCycles(Graph* graph) {
-    int size;
-    int* idMap;
-    mapIdsToIndices(graph, idMap, size);
-    if (size == 0) { delete[] idMap; return false; }
-
-    bool* visited = new bool[size];
-    for (int i = 0; i < size; ++i) visited[i] = false;
-
-    bool result = false;
-    if (graph->isDirected()) {
-        bool* recStack = new bool[size];
-        for (int i = 0; i < size; ++i) recStack[i] = false;
-        
-        for (int i = 0; i < size; ++i) {
-            if (hasCyclesRecursive(graph, i, visited, recStack, idMap, size)) {
-                result = true;
-                break;
+double* GraphAlgorithms::getClosenessCentrality(Graph* graph, int*& idMap, int& size,
+                                                int samples, double* errorBound, ThreadPool* pool) {
+    if (!pool) pool = &ThreadPool::global();
+    if (errorBound) *errorBound = 0;
+
+    bool sampled = samples > 0 && (size_t)samples < graph->getVertices().size();
+    CompactGraph cg(graph, sampled && graph->isDirected());
+    size = cg.vertexCount();
+    idMap = cg.copyIdMap();
+    double* closeness = new double[size > 0 ? size : 1];
+    if (size == 0) return closeness;
+
+    bool weighted = cg.isWeighted();
+    for (int s = 0; weighted && s < cg.edgeCount(); ++s) {
+        if (cg.weight(s) < 0) {
+            // Dijkstra can't handle these; fall back to the distance matrix
+            delete[] idMap;
+            int** dists = getAllPairsShortestPaths(graph, size, idMap, ApspMode::FloydWarshall, pool);
+            for (int i = 0; i < size; ++i) {
+                double sumDist = 0;
+                int reachable = 0;
+                for (int j = 0; j < size; ++j) {
+                    if (i != j && dists[i][j] < INF) {
+                        sumDist += dists[i][j];
+                        reachable++;
+                    }
+                }
+                closeness[i] = sumDist > 0 ? (double)reachable / sumDist : 0;
             }
+            freeMatrix(dists, size);
+            return closeness;
         }
-        delete[] recStack;
-    } else {
-        for (int i = 0; i < size; ++i) {
-            if (!visited[i]) {
-                if (hasCyclesUndirected(graph, i, visited, -1, idMap, size)) {
-                    result = true;
-                    break;
+    }
+
+    // Per-worker scratch, O(V) each
+    int workers = pool->threadCount();
+    int** dist = new int*[workers];
+    int** queue = new int*[workers];
+    IndexedMinHeap<int>** heaps = new IndexedMinHeap<int>*[workers];
+    for (int w = 0; w < workers; ++w) {
+        dist[w] = new int[size];
+        queue[w] = new int[size];
+        heaps[w] = new IndexedMinHeap<int>(size);
+    }
+
+    if (!sampled) {
+        // Exact: one search per vertex, reduced straight to its score
+        pool->parallelFor(0, size, 1, [&](int source, int w) {
+            distancesFrom(size, cg.offsetArray(), cg.targetArray(), cg.weightArray(), weighted,
+                          source, dist[w], queue[w], *heaps[w]);
+            double sumDist = 0;
+            int reachable = 0;
+            for (int j = 0; j < size; ++j) {
+                if (j != source && dist[w][j] < INF) {
+                    sumDist += dist[w][j];
+                    reachable++;
                 }
             }
+            closeness[source] = sumDist > 0 ? (double)reachable / sumDist : 0;
+        });
+    } else {
+        // Sampled (Eppstein-Wang): search from `samples` random pivots on the
+        // reversed graph, which gives every vertex's distance *to* each pivot.
+        // The mean over the pivots estimates the mean over all vertices.
+        int* pivots = new int[size];
+        for (int i = 0; i < size; ++i) pivots[i] = i;
+        for (int i = 0; i < samples; ++i) { // partial Fisher-Yates, fixed seed
+            int j = i + (int)(hashMix((uint64_t)i + 0x5eed) % (uint64_t)(size - i));
+            int t = pivots[i];
+            pivots[i] = pivots[j];
+            pivots[j] = t;
         }
-    }
 
-    delete[] visited;
-    delete[] idMap;
-    return result;
-}
-double* GraphAlgorithms::getClosenessCentrality(Graph* graph, int*& idMap, int& size) {
-    int** dists = getAllPairsShortestPaths(graph, size, idMap);
-    if (!dists) return nullptr;
+        const int* offsets = cg.isDirected() ? cg.reverseOffsetArray() : cg.offsetArray();
+        const int* targets = cg.isDirected() ? cg.reverseSourceArray() : cg.targetArray();
+        const int* weights = cg.isDirected() ? cg.reverseWeightArray() : cg.weightArray();
+        double** sums = new double*[workers];
+        int** counts = new int*[workers];
+        for (int w = 0; w < workers; ++w) {
+            sums[w] = new double[size];
+            counts[w] = new int[size];
+            for (int i = 0; i < size; ++i) {
+                sums[w][i] = 0;
+                counts[w][i] = 0;
+            }
+        }
 
-    double* closeness = new double[size];
-    for (int i = 0; i < size; ++i) {
-        double sumDist = 0;
-        int reachable = 0;
-        for (int j = 0; j < size; ++j) {
-            if (i != j && dists[i][j] < INF) {
-                sumDist += dists[i][j];
-                reachable++;
+        pool->parallelFor(0, samples, 1, [&](int k, int w) {
+            int pivot = pivots[k];
+            distancesFrom(size, offsets, targets, weights, weighted, pivot, dist[w], queue[w], *heaps[w]);
+            for (int v = 0; v < size; ++v) {
+                if (v != pivot && dist[w][v] < INF) {
+                    sums[w][v] += dist[w][v];
+                    counts[w][v]++;
+                }
+            }
+        });
+
+        for (int v = 0; v < size; ++v) {
+            double sumDist = 0;
+            long long reachable = 0;
+            for (int w = 0; w < workers; ++w) {
+                sumDist += sums[w][v];
+                reachable += counts[w][v];
             }
+            closeness[v] = sumDist > 0 ? (double)reachable / sumDist : 0;
         }
-        if (sumDist > 0) {
-            closeness[i] = (double)reachable / sumDist;
-        } else {
-            closeness[i] = 0;
+
+        // Hoeffding plus a union bound over all vertices: with probability
+        // at least 1 - 1/V every estimated mean distance is within
+        // errorBound * diameter of the exact one
+        if (errorBound) *errorBound = std::sqrt(std::log(2.0 * size * size) / (2.0 * samples));
+
+        for (int w = 0; w < workers; ++w) {
+            delete[] sums[w];
+            delete[] counts[w];
         }
+        delete[] sums;
+        delete[] counts;
+        delete[] pivots;
     }
 
-    freeMatrix(dists, size);
+    for (int w = 0; w < workers; ++w) {
+        delete[] dist[w];
+        delete[] queue[w];
+        delete heaps[w];
+    }
+    delete[] dist;
+    delete[] queue;
+    delete[] heaps;
     return closeness;
 }
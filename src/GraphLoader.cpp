@@ -0,0 +1,193 @@
+#include "GraphLoader.h"
+#include "BinaryGraphFile.h"
+#include "CompressedGraphFile.h"
+#include "FileController.h"
+#include "MappedFile.h"
+#include <condition_variable>
+#include <cstring>
+
+// Discarded loaders whose worker hasn't finished yet
+static std::mutex discardedLock;
+static std::condition_variable discardedGone;
+static int discardedCount = 0;
+
+template <typename T>
+void GraphLoader::Queue<T>::append(T* from, int n) {
+    if (n == 0) return;
+    if (head == count) head = count = 0; // drained: reuse from the start
+    if (count + n > capacity) {
+        int grown = capacity == 0 ? kStageSize : capacity;
+        while (grown < count - head + n) grown *= 2;
+        T* bigger = new T[grown];
+        if (count > head) std::memcpy(bigger, items + head, (count - head) * sizeof(T));
+        delete[] items;
+        items = bigger;
+        capacity = grown;
+        count -= head;
+        head = 0;
+    }
+    std::memcpy(items + count, from, n * sizeof(T));
+    count += n;
+}
+
+template <typename T>
+int GraphLoader::Queue<T>::takeInto(T* out, int max) {
+    int n = count - head < max ? count - head : max;
+    if (n > 0) std::memcpy(out, items + head, n * sizeof(T));
+    head += n;
+    return n;
+}
+
+GraphLoader::GraphLoader(const std::string& path, ThreadPool* pool)
+    : path(path), pool(pool), stagedVertexCount(0), stagedEdgeCount(0), graph(nullptr), done(false),
+      discarded(false), canceled(false), bytesDone(0), bytesTotal(0) {}
+
+GraphLoader::~GraphLoader() {
+    cancel();
+    if (worker.joinable()) worker.join();
+    delete graph;
+}
+
+void GraphLoader::discard() {
+    std::unique_lock<std::mutex> guard(lock);
+    canceled = true;
+    if (done || !worker.joinable()) { // nothing left to wait for
+        guard.unlock();
+        delete this;
+        return;
+    }
+    // run() reads `discarded` under the lock, so exactly one side deletes
+    discarded = true;
+    worker.detach();
+    std::lock_guard<std::mutex> count(discardedLock);
+    discardedCount++;
+}
+
+void GraphLoader::waitForDiscarded() {
+    std::unique_lock<std::mutex> count(discardedLock);
+    discardedGone.wait(count, [] { return discardedCount == 0; });
+}
+
+void GraphLoader::start() {
+    worker = std::thread(&GraphLoader::run, this);
+}
+
+void GraphLoader::cancel() {
+    canceled = true;
+}
+
+double GraphLoader::progress() const {
+    size_t total = bytesTotal.load();
+    return total > 0 ? (double)bytesDone.load() / total : 0.0;
+}
+
+void GraphLoader::run() {
+    Graph* loaded = nullptr;
+    std::string problems;
+    MappedFile file;
+    if (!file.open(path)) {
+        problems = "no se pudo abrir el archivo";
+    } else if (BinaryGraphFile::hasMagic(file.data(), file.size()) ||
+               CompressedGraphFile::hasMagic(file.data(), file.size())) {
+        // These decode in a fraction of the time it takes to show the
+        // result, so load whole and publish afterwards
+        bytesTotal = file.size();
+        file.close();
+        loaded = FileController::loadGraph(path, &problems);
+        if (loaded) publishAll(loaded);
+    } else {
+        bytesTotal = file.size();
+        GraphTextParser parser(file.data(), file.size());
+        parser.setListener(this);
+        loaded = parser.parse(pool);
+        problems = parser.errorSummary();
+        flush();
+    }
+    bytesDone = bytesTotal.load();
+
+    bool orphaned;
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (canceled) {
+            delete loaded; // nothing of it may be used any more
+            loaded = nullptr;
+        }
+        graph = loaded;
+        message = problems;
+        done = true;
+        orphaned = discarded;
+    }
+    if (orphaned) {
+        delete this;
+        std::lock_guard<std::mutex> count(discardedLock);
+        discardedCount--;
+        discardedGone.notify_all();
+    }
+}
+
+void GraphLoader::publishAll(Graph* loaded) {
+    for (auto v : loaded->getVertices()) {
+        if (canceled) return;
+        vertexAdded(v);
+    }
+    for (auto v : loaded->getVertices()) {
+        if (canceled) return;
+        for (auto e : v->edges) {
+            stagedEdges[stagedEdgeCount++] = e;
+            if (stagedEdgeCount == kStageSize) flush();
+        }
+    }
+    flush();
+}
+
+void GraphLoader::vertexAdded(Vertex* vertex) {
+    stagedVertices[stagedVertexCount++] = vertex;
+    if (stagedVertexCount == kStageSize) flush();
+}
+
+void GraphLoader::edgeAdded(Edge* edge) {
+    if (stagedEdgeCount + 2 > kStageSize) flush();
+    stagedEdges[stagedEdgeCount++] = edge;
+    if (edge->twin) stagedEdges[stagedEdgeCount++] = edge->twin;
+}
+
+bool GraphLoader::progress(size_t done, size_t total) {
+    bytesDone = done;
+    bytesTotal = total;
+    flush(); // let the consumer see what this stretch of the file produced
+    return !canceled;
+}
+
+bool GraphLoader::workerProgress(size_t done, size_t total) {
+    bytesDone = done;
+    bytesTotal = total;
+    return !canceled;
+}
+
+void GraphLoader::flush() {
+    if (stagedVertexCount == 0 && stagedEdgeCount == 0) return;
+    std::lock_guard<std::mutex> guard(lock);
+    // Vertices go in first: take() then never sees an edge before its ends
+    vertexQueue.append(stagedVertices, stagedVertexCount);
+    edgeQueue.append(stagedEdges, stagedEdgeCount);
+    stagedVertexCount = stagedEdgeCount = 0;
+}
+
+void GraphLoader::take(int max, Vertex** vertices, int& vertexCount, Edge** edges, int& edgeCount) {
+    std::lock_guard<std::mutex> guard(lock);
+    vertexCount = vertexQueue.takeInto(vertices, max);
+    edgeCount = vertexQueue.isEmpty() ? edgeQueue.takeInto(edges, max - vertexCount) : 0;
+}
+
+bool GraphLoader::isFinished() {
+    std::lock_guard<std::mutex> guard(lock);
+    return done && vertexQueue.isEmpty() && edgeQueue.isEmpty();
+}
+
+Graph* GraphLoader::takeGraph() {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!done || canceled) return nullptr;
+    Graph* result = graph;
+    graph = nullptr;
+    return result;
+}
@@ -0,0 +1,348 @@
+#include "GraphTextParser.h"
+#include "ThreadPool.h"
+#include <atomic>
+#include <charconv>
+#include <cstring>
+
+GraphTextParser::GraphTextParser(const char* data, size_t size)
+    : data(data), size(size), totalErrors(0), listener(nullptr), stopped(false) {}
+
+void GraphTextParser::report(int line, const std::string& message) {
+    if (totalErrors++ < kMaxStoredErrors) errorList.push_back({line, message});
+}
+
+std::string GraphTextParser::errorSummary() {
+    std::string summary;
+    for (auto& e : errorList) {
+        summary += "línea " + std::to_string(e.line) + ": " + e.message + "\n";
+    }
+    if (totalErrors > kMaxStoredErrors) {
+        summary += "... y " + std::to_string(totalErrors - kMaxStoredErrors) + " errores más\n";
+    }
+    return summary;
+}
+
+static inline bool isBlank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+// Reads one int at p (leading/trailing blanks allowed) and moves p past it.
+// Up to 9 digits can't overflow, so those are accumulated inline; anything
+// longer (or odd) goes through std::from_chars, which does the range check.
+static inline bool readInt(const char*& p, const char* end, int& value) {
+    while (p < end && isBlank(*p)) ++p;
+    if (p < end && *p == '+') ++p; // from_chars rejects the sign stoi accepted
+    const char* q = p;
+    bool negative = q < end && *q == '-';
+    if (negative) ++q;
+    const char* digits = q;
+    unsigned magnitude = 0;
+    while (q < end && q - digits < 9 && (unsigned)(*q - '0') < 10) magnitude = magnitude * 10 + (unsigned)(*q++ - '0');
+    if (q > digits && (q == end || (unsigned)(*q - '0') >= 10)) {
+        value = negative ? -(int)magnitude : (int)magnitude;
+        p = q;
+    } else {
+        std::from_chars_result r = std::from_chars(p, end, value);
+        if (r.ec != std::errc()) return false;
+        p = r.ptr;
+    }
+    while (p < end && isBlank(*p)) ++p;
+    return true;
+}
+
+// Fast path for the common edge line "src,dest,weight\n" with no blanks:
+// one pass over the bytes, no separate search for the line end. Returns
+// false (without consuming anything) for anything else, including the last
+// line of a file without a trailing newline; the caller then takes the
+// general per-line path.
+static inline bool quickEdgeLine(const char*& p, const char* limit, int& src, int& dest, int& weight) {
+    const char* q = p;
+    if (!readInt(q, limit, src) || q == limit || *q++ != ',') return false;
+    if (!readInt(q, limit, dest) || q == limit || *q++ != ',') return false;
+    if (!readInt(q, limit, weight) || q == limit) return false;
+    if (*q == '\r') ++q;
+    if (q == limit || *q != '\n') return false;
+    p = q + 1;
+    return true;
+}
+
+const char* GraphTextParser::parseEdgeLine(const char* begin, const char* end, int& src, int& dest, int& weight) {
+    const char* p = begin;
+    if (!readInt(p, end, src) || p == end || *p++ != ',') return "origen inválido";
+    if (!readInt(p, end, dest) || p == end || *p++ != ',') return "destino inválido";
+    if (!readInt(p, end, weight)) return "peso inválido";
+    if (p != end) return "texto sobrante al final de la arista";
+    return nullptr;
+}
+
+const char* GraphTextParser::parseNodeLine(const char* begin, const char* end, int& id,
+                                           const char*& label, size_t& labelLength, int& x, int& y) {
+    const char* p = begin;
+    if (!readInt(p, end, id) || p == end || *p++ != ',') return "ID de nodo inválido";
+
+    // x and y are the last two fields, so the label may contain commas
+    const char* lastComma = end;
+    while (lastComma > p && lastComma[-1] != ',') --lastComma;
+    if (lastComma == p) return "faltan las coordenadas";
+    const char* yStart = lastComma;
+    --lastComma;
+    const char* xStart = lastComma;
+    while (xStart > p && xStart[-1] != ',') --xStart;
+    if (xStart == p) return "faltan las coordenadas";
+
+    label = p;
+    labelLength = (size_t)(xStart - 1 - p);
+    const char* q = xStart;
+    if (!readInt(q, lastComma, x) || q != lastComma) return "coordenada x inválida";
+    q = yStart;
+    if (!readInt(q, end, y) || q != end) return "coordenada y inválida";
+    return nullptr;
+}
+
+// Header lines are compared without surrounding blanks
+static bool lineIs(const char* begin, const char* end, const char* word) {
+    size_t length = std::strlen(word);
+    return (size_t)(end - begin) == length && std::memcmp(begin, word, length) == 0;
+}
+
+void GraphTextParser::addEdge(Graph* graph, int line, int src, int dest, int weight) {
+    Vertex* from = graph->getVertex(src);
+    Vertex* to = graph->getVertex(dest);
+    if (!from || !to) {
+        report(line, "arista hacia un nodo inexistente");
+        return;
+    }
+    // Repeated edges are normal: undirected graphs list both directions
+    Edge* edge = graph->addEdge(from, to, weight);
+    if (edge && listener) listener->edgeAdded(edge);
+}
+
+// Below this the EDGES section is parsed on the calling thread
+static const size_t kParallelMinBytes = 1 << 20;
+
+struct ParsedEdge {
+    Vertex* from;
+    Vertex* to;
+    int weight;
+};
+
+// State the slices of one parallel parse share: the bytes they have read
+// between them, for progress, and whether the listener asked to stop
+struct SliceProgress {
+    GraphTextListener* listener;
+    size_t start;  // offset of the section in the buffer
+    size_t total;  // size of the buffer
+    size_t bytes;  // of the section
+    std::atomic<size_t> read;
+    std::atomic<bool> stop;
+
+    SliceProgress(GraphTextListener* listener, size_t start, size_t total, size_t bytes)
+        : listener(listener), start(start), total(total), bytes(bytes), read(0), stop(false) {}
+
+    // The section counts twice, read by the slices and then merged, so the
+    // reported position keeps moving through both phases
+    size_t position(size_t halves) const { return start + halves / 2; }
+
+    bool keepGoing(size_t justRead) {
+        size_t sum = read += justRead;
+        if (listener && !stop && !listener->workerProgress(position(sum), total)) stop = true;
+        return !stop;
+    }
+};
+
+// One slice of the EDGES section and what a worker made of it. Line numbers
+// in `errors` are relative to the slice until the merge.
+struct EdgeSlice {
+    SliceProgress* shared;
+    const char* begin;
+    const char* end;
+    ParsedEdge* edges;
+    size_t count;
+    size_t capacity;
+    LinkedList<TextParseError> errors;
+    int errorTotal;
+    int lines;
+    bool sectionChange; // hit a NODES/EDGES line: only the serial parse handles that
+
+    EdgeSlice() : shared(nullptr), begin(nullptr), end(nullptr), edges(nullptr), count(0), capacity(0),
+                  errorTotal(0), lines(0), sectionChange(false) {}
+    ~EdgeSlice() { delete[] edges; }
+
+    void fail(int line, const char* message) {
+        if (errorTotal++ < GraphTextParser::kMaxStoredErrors) errors.push_back({line, message});
+    }
+
+    void add(Graph* graph, int line, int src, int dest, int weight) {
+        Vertex* from = graph->getVertex(src); // read-only lookups, safe to share
+        Vertex* to = graph->getVertex(dest);
+        if (!from || !to) {
+            fail(line, "arista hacia un nodo inexistente");
+            return;
+        }
+        if (count == capacity) {
+            size_t grown = capacity == 0 ? 1024 : capacity * 2;
+            ParsedEdge* bigger = new ParsedEdge[grown];
+            if (count) std::memcpy(bigger, edges, count * sizeof(ParsedEdge));
+            delete[] edges;
+            edges = bigger;
+            capacity = grown;
+        }
+        edges[count++] = ParsedEdge{from, to, weight};
+    }
+
+    void parse(Graph* graph) {
+        const char* p = begin;
+        const char* counted = begin; // read up to here is in shared->read
+        while (p < end) {
+            if ((lines & 0xfff) == 0) {
+                bool go = shared->keepGoing((size_t)(p - counted));
+                counted = p;
+                if (!go) return;
+            }
+            int src, dest, weight;
+            if (quickEdgeLine(p, end, src, dest, weight)) {
+                add(graph, ++lines, src, dest, weight);
+                continue;
+            }
+            const char* newline = (const char*)std::memchr(p, '\n', (size_t)(end - p));
+            const char* lineEnd = newline ? newline : end;
+            const char* lineBegin = p;
+            p = newline ? newline + 1 : end;
+            lines++;
+
+            while (lineEnd > lineBegin && (lineEnd[-1] == '\r' || isBlank(lineEnd[-1]))) --lineEnd;
+            while (lineBegin < lineEnd && isBlank(*lineBegin)) ++lineBegin;
+            if (lineBegin == lineEnd) continue;
+            if (lineIs(lineBegin, lineEnd, "NODES") || lineIs(lineBegin, lineEnd, "EDGES")) {
+                sectionChange = true;
+                return;
+            }
+            const char* problem = GraphTextParser::parseEdgeLine(lineBegin, lineEnd, src, dest, weight);
+            if (problem) fail(lines, problem);
+            else add(graph, lines, src, dest, weight);
+        }
+        shared->keepGoing((size_t)(p - counted));
+    }
+};
+
+// Parses the edge lines in [begin, end), which runs to the end of the
+// buffer. Returns false, having added nothing, if the section is too small
+// to bother or another section starts inside it; the caller then goes on
+// line by line.
+bool GraphTextParser::parseEdgesParallel(Graph* graph, const char* begin, const char* end, int linesBefore,
+                                         ThreadPool* pool) {
+    size_t bytes = (size_t)(end - begin);
+    if (pool->threadCount() < 2 || bytes < kParallelMinBytes) return false;
+
+    // A few slices per thread so work stealing can even out slow ones
+    int sliceCount = pool->threadCount() * 4;
+    EdgeSlice* slices = new EdgeSlice[sliceCount];
+    SliceProgress shared(listener, (size_t)(begin - data), size, bytes);
+    const char* cut = begin;
+    for (int i = 0; i < sliceCount; ++i) {
+        slices[i].shared = &shared;
+        slices[i].begin = cut;
+        const char* target = (i == sliceCount - 1) ? end : begin + bytes / sliceCount * (i + 1);
+        if (target < cut) target = cut;
+        const char* newline = target < end ? (const char*)std::memchr(target, '\n', (size_t)(end - target)) : nullptr;
+        cut = newline ? newline + 1 : end;
+        slices[i].end = cut;
+    }
+
+    pool->parallelFor(0, sliceCount, 1, [&](int i, int) { slices[i].parse(graph); });
+    if (shared.stop) {
+        stopped = true;
+        delete[] slices;
+        return true;
+    }
+
+    for (int i = 0; i < sliceCount; ++i) {
+        if (slices[i].sectionChange) {
+            delete[] slices;
+            return false;
+        }
+    }
+
+    // Single merge in file order, so duplicates resolve exactly as in the
+    // serial parse and errors come out sorted by line
+    int lineOffset = linesBefore;
+    for (int i = 0; i < sliceCount && !stopped; ++i) {
+        EdgeSlice& slice = slices[i];
+        for (size_t k = 0; k < slice.count; ++k) {
+            Edge* edge = graph->addEdge(slice.edges[k].from, slice.edges[k].to, slice.edges[k].weight);
+            if (edge && listener) listener->edgeAdded(edge);
+        }
+        for (auto& e : slice.errors) report(lineOffset + e.line, e.message);
+        totalErrors += slice.errorTotal - (int)slice.errors.size();
+        lineOffset += slice.lines;
+        if (listener && !listener->progress(shared.position(bytes + (size_t)(slice.end - begin)), size)) stopped = true;
+    }
+    delete[] slices;
+    return true;
+}
+
+Graph* GraphTextParser::parse(ThreadPool* pool) {
+    enum Section { Header, Nodes, Edges } section = Header;
+    bool directed = false;
+    bool weighted = false;
+    Graph* graph = nullptr;
+
+    const char* p = data;
+    const char* limit = data + size;
+    int line = 0;
+    stopped = false;
+    while (p < limit) {
+        if (listener && (line & 0x3fff) == 0 && !listener->progress((size_t)(p - data), size)) {
+            stopped = true;
+            break;
+        }
+        int src, dest, weight;
+        if (section == Edges && quickEdgeLine(p, limit, src, dest, weight)) {
+            addEdge(graph, ++line, src, dest, weight);
+            continue;
+        }
+
+        const char* newline = (const char*)std::memchr(p, '\n', (size_t)(limit - p));
+        const char* end = newline ? newline : limit;
+        const char* begin = p;
+        p = newline ? newline + 1 : limit;
+        line++;
+
+        while (end > begin && (end[-1] == '\r' || isBlank(end[-1]))) --end;
+        while (begin < end && isBlank(*begin)) ++begin;
+        if (begin == end) continue;
+
+        if (lineIs(begin, end, "NODES") || lineIs(begin, end, "EDGES")) {
+            if (!graph) graph = new Graph(directed, weighted);
+            section = (*begin == 'N') ? Nodes : Edges;
+            if (section == Edges && pool && parseEdgesParallel(graph, p, limit, line, pool)) break;
+            continue;
+        }
+
+        if (section == Header) {
+            if (lineIs(begin, end, "TYPE:DIRECTED")) directed = true;
+            else if (lineIs(begin, end, "TYPE:UNDIRECTED")) directed = false;
+            else if (lineIs(begin, end, "WEIGHTED:TRUE")) weighted = true;
+            else if (lineIs(begin, end, "WEIGHTED:FALSE")) weighted = false;
+            else report(line, "encabezado desconocido");
+        } else if (section == Nodes) {
+            int id, x, y;
+            const char* label;
+            size_t labelLength;
+            const char* problem = parseNodeLine(begin, end, id, label, labelLength, x, y);
+            if (problem) report(line, problem);
+            else {
+                Vertex* vertex = graph->addVertex(id, std::string(label, labelLength), x, y);
+                if (!vertex) report(line, "ID de nodo repetido");
+                else if (listener) listener->vertexAdded(vertex);
+            }
+        } else {
+            const char* problem = parseEdgeLine(begin, end, src, dest, weight);
+            if (problem) report(line, problem);
+            else addEdge(graph, line, src, dest, weight);
+        }
+    }
+
+    if (!graph) graph = new Graph(directed, weighted);
+    return graph;
+}
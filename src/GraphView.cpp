@@ -1,42 +1,164 @@
 #include "GraphView.h"
+#include "GraphLoader.h"
+#include "ThreadPool.h"
+#include <QElapsedTimer>
+#include <QTimer>
 #include <QMouseEvent>
-#include <QGraphicsTextItem>
+#include <algorithm>
 #include <cmath>
-#include <QGraphicsDropShadowEffect>
+#include <QCoreApplication>
+#include <QPixmap>
+#include <QStyle>
 #include <QPainter>
 #include <QScrollBar>
+#include <QStyleOptionGraphicsItem>
+#include <QFontMetricsF>
+
+static qreal levelOfDetail(QPainter* painter) {
+    return QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+}
+
+const QFont& nodeLabelFont() {
+    static const QFont font("Segoe UI", 9, QFont::Bold);
+    return font;
+}
+
+const QFont& edgeWeightFont() {
+    static QFont font;
+    static bool ready = false;
+    if (!ready) {
+        font.setPointSize(8);
+        font.setBold(true);
+        ready = true;
+    }
+    return font;
+}
+
+// Every node looks the same but for its label and whether it is
+// highlighted, so the circle with its gradient, outline and shadow is drawn
+// once per look and zoom into a pixmap all nodes share. Zooms are bucketed
+// in powers of two and a node takes the bucket at or above its scale, so the
+// pixmap is only ever shrunk; zoomed in past the largest bucket, the node is
+// painted straight instead.
+enum NodeLook { NormalLook, HighlightedLook };
+static const int kZoomBuckets = 7; // 1/4 to 16 device pixels per scene unit
+static const int kSmallestZoomExponent = -2;
+static const qreal kLargestSpriteZoom = 16; // the top bucket
+// The circle (radius 15) and its shadow, 4 below and spreading 8 around
+static const QRectF kNodeSprite(-23, -19, 46, 50);
+
+static QPixmap* nodeSprites[2][2][kZoomBuckets];
+
+static void dropNodeSprites() {
+    for (auto& byShadow : nodeSprites)
+        for (auto& byZoom : byShadow)
+            for (QPixmap*& sprite : byZoom) {
+                delete sprite;
+                sprite = nullptr;
+            }
+}
+
+static void paintNodeLook(QPainter* painter, NodeLook look, bool shadow) {
+    painter->setRenderHint(QPainter::Antialiasing);
+    if (shadow) {
+        QRadialGradient fade(0, 4, 23);
+        fade.setColorAt(0, QColor(0, 0, 0, 120));
+        fade.setColorAt(0.5, QColor(0, 0, 0, 90));
+        fade.setColorAt(1, QColor(0, 0, 0, 0));
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(fade);
+        painter->drawEllipse(QPointF(0, 4), 23, 23);
+    }
+    QRadialGradient gradient(0, 0, 15, -5, -5);
+    if (look == HighlightedLook) {
+        gradient.setColorAt(0, QColor(100, 255, 100));
+        gradient.setColorAt(1, QColor(0, 150, 0));
+        painter->setPen(QPen(Qt::white, 2));
+    } else {
+        gradient.setColorAt(0, QColor(255, 255, 255));
+        gradient.setColorAt(1, QColor(200, 205, 210));
+        painter->setPen(QPen(QColor(40, 42, 45, 180), 1.5));
+    }
+    painter->setBrush(gradient);
+    painter->drawEllipse(QRectF(-15, -15, 30, 30));
+}
+
+// `scale` is device pixels per scene unit; `size` is set to the pixmap's
+static const QPixmap& nodeSprite(NodeLook look, bool shadow, qreal scale, qreal& size) {
+    int bucket = (int)std::ceil(std::log2(scale)) - kSmallestZoomExponent;
+    bucket = std::max(0, std::min(kZoomBuckets - 1, bucket));
+    QPixmap*& sprite = nodeSprites[look][shadow][bucket];
+    size = std::ldexp(1.0, bucket + kSmallestZoomExponent);
+    if (!sprite) {
+        static bool registered = false;
+        if (!registered) {
+            qAddPostRoutine(dropNodeSprites); // before the application goes
+            registered = true;
+        }
+        sprite = new QPixmap((int)std::ceil(kNodeSprite.width() * size), (int)std::ceil(kNodeSprite.height() * size));
+        sprite->fill(Qt::transparent);
+        QPainter painter(sprite);
+        painter.scale(size, size);
+        painter.translate(-kNodeSprite.left(), -kNodeSprite.top());
+        paintNodeLook(&painter, look, shadow);
+    }
+    return *sprite;
+}
 
 // ================= VisualNode =================
 VisualNode::VisualNode(Vertex* v, GraphView* view) 
-    : vertex(v), view(view) 
+    : vertex(v), view(view), highlighted(false)
 {
     setRect(-15, -15, 30, 30);
-    
-    QRadialGradient gradient(0, 0, 15, -5, -5);
-    gradient.setColorAt(0, QColor(255, 255, 255));
-    gradient.setColorAt(1, QColor(200, 205, 210));
-    setBrush(gradient);
-    
-    setPen(QPen(QColor(40, 42, 45, 180), 1.5));
     setFlags(ItemIsMovable | ItemIsSelectable | ItemSendsGeometryChanges);
     
-    // Premium Drop Shadow
-    QGraphicsDropShadowEffect* shadow = new QGraphicsDropShadowEffect();
-    shadow->setBlurRadius(15);
-    shadow->setOffset(0, 4);
-    shadow->setColor(QColor(0, 0, 0, 120));
-    setGraphicsEffect(shadow);
-    
-    // Label - cleaner look
-    QGraphicsTextItem* text = new QGraphicsTextItem(QString::fromStdString(v->label), this);
-    text->setDefaultTextColor(QColor(240, 240, 240));
-    QFont font("Segoe UI", 9, QFont::Bold);
-    text->setFont(font);
-    text->setPos(-10, -38);
+    // Label - cleaner look, painted by the node itself (see paint)
+    labelText = QString::fromStdString(v->label);
+    QFontMetricsF metrics(nodeLabelFont());
+    labelRect = QRectF(-6, -34, metrics.horizontalAdvance(labelText), metrics.height());
     
     setPos(v->x, v->y);
 }
 
+QRectF VisualNode::boundingRect() const {
+    return QGraphicsEllipseItem::boundingRect().united(kNodeSprite).united(labelRect);
+}
+
+void VisualNode::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *) {
+    qreal lod = levelOfDetail(painter);
+    if (lod < kLodFlat) {
+        // A few pixels wide: a flat dot in the gradient's outer color
+        painter->setRenderHint(QPainter::Antialiasing, false);
+        painter->setPen(Qt::NoPen);
+        painter->setBrush(highlighted ? QColor(0, 150, 0) : QColor(200, 205, 210));
+        painter->drawEllipse(rect());
+        return;
+    }
+    // Shadows only when zoomed in enough to see them
+    NodeLook look = highlighted ? HighlightedLook : NormalLook;
+    qreal scale = lod * painter->device()->devicePixelRatioF();
+    if (scale > kLargestSpriteZoom) {
+        painter->save();
+        paintNodeLook(painter, look, true);
+        painter->restore();
+    } else {
+        qreal size;
+        const QPixmap& sprite = nodeSprite(look, lod >= kLodShadows, scale, size);
+        painter->setRenderHint(QPainter::SmoothPixmapTransform);
+        painter->drawPixmap(kNodeSprite, sprite, QRectF(0, 0, kNodeSprite.width() * size, kNodeSprite.height() * size));
+    }
+    if (option->state & QStyle::State_Selected) {
+        painter->setPen(QPen(QColor(240, 240, 240), 0, Qt::DashLine));
+        painter->setBrush(Qt::NoBrush);
+        painter->drawRect(rect());
+    }
+    if (lod >= kLodLabels && !labelText.isEmpty()) {
+        painter->setFont(nodeLabelFont());
+        painter->setPen(QColor(240, 240, 240));
+        painter->drawText(labelRect, Qt::AlignLeft | Qt::AlignTop, labelText);
+    }
+}
+
 void VisualNode::mousePressEvent(QGraphicsSceneMouseEvent *event) {
     oldPos = pos();
     view->nodeClicked(this);
@@ -44,8 +166,8 @@ void VisualNode::mousePressEvent(QGraphicsSceneMouseEvent *event) {
 }
 
 void VisualNode::mouseMoveEvent(QGraphicsSceneMouseEvent *event) {
+    // The edges follow through itemChange
     QGraphicsEllipseItem::mouseMoveEvent(event);
-    view->nodeMoved(this);
 }
 
 void VisualNode::mouseReleaseEvent(QGraphicsSceneMouseEvent *event) {
@@ -63,52 +185,67 @@ QVariant VisualNode::itemChange(GraphicsItemChange change, const QVariant &value
 }
 
 void VisualNode::setHighlighted(bool high) {
-    if(high) {
-        QRadialGradient highGrad(0, 0, 15, -5, -5);
-        highGrad.setColorAt(0, QColor(100, 255, 100));
-        highGrad.setColorAt(1, QColor(0, 150, 0));
-        setBrush(highGrad);
-        setPen(QPen(Qt::white, 2));
-    } else {
-        QRadialGradient normGrad(0, 0, 15, -5, -5);
-        normGrad.setColorAt(0, QColor(240, 240, 240));
-        normGrad.setColorAt(1, QColor(180, 180, 180));
-        setBrush(normGrad);
-        setPen(QPen(QColor(60, 60, 60), 1.5));
-    }
+    if (highlighted == high) return;
+    highlighted = high;
+    update(); // the other look comes from the shared pixmaps
 }
 
 
 // ================= VisualEdge =================
 VisualEdge::VisualEdge(Edge* e, VisualNode* src, VisualNode* dest) 
-    : edgeRaw(e), sourceNode(src), destNode(dest)
+    : updatePending(false), edgeRaw(e), sourceNode(src), destNode(dest)
 {
+    sourcePos = src->incidentEdges().push_back(this);
+    destPos = dest->incidentEdges().push_back(this);
+
     setPen(QPen(QColor(160, 160, 160), 2));
     setZValue(-1); // Behind nodes
     
-    weightLabel = new QGraphicsTextItem(this);
-    weightLabel->setDefaultTextColor(QColor(180, 180, 180));
-    QFont font = weightLabel->font();
-    font.setPointSize(8);
-    font.setBold(true);
-    weightLabel->setFont(font);
-    
-    weightLabel->setPlainText(QString::number(e->weight));
+    // Weight label, painted by the edge itself (see paint)
+    weightText = QString::number(e->weight);
+    QFontMetricsF metrics(edgeWeightFont());
+    weightSize = QSizeF(metrics.horizontalAdvance(weightText), metrics.height());
 
     updatePosition();
 }
 
 void VisualEdge::updatePosition() {
     if (!sourceNode || !destNode) return;
-    QLineF line(sourceNode->pos(), destNode->pos());
-    setLine(line);
-    
-    // Update label position at center
-    QPointF center = line.center();
-    weightLabel->setPos(center.x() - weightLabel->boundingRect().width()/2, center.y() - weightLabel->boundingRect().height()/2);
-    
-    // Rotate label to follow line? (Optional, maybe keep horizontal for readability)
-    // For now keep it simple.
+    // The weight is placed from the line, so it moves along with it
+    setLine(QLineF(sourceNode->pos(), destNode->pos()));
+}
+
+QRectF VisualEdge::weightRect() const {
+    QPointF center = line().center();
+    return QRectF(center.x() - weightSize.width() / 2, center.y() - weightSize.height() / 2,
+                  weightSize.width(), weightSize.height());
+}
+
+QRectF VisualEdge::boundingRect() const {
+    return QGraphicsLineItem::boundingRect().united(weightRect());
+}
+
+void VisualEdge::paint(QPainter *painter, const QStyleOptionGraphicsItem *, QWidget *) {
+    qreal lod = levelOfDetail(painter);
+    QPen linePen = pen();
+    if (lod < kLodFlat) {
+        linePen.setWidthF(0); // cosmetic: one device pixel at any zoom
+        painter->setRenderHint(QPainter::Antialiasing, false);
+    }
+    painter->setPen(linePen);
+    painter->drawLine(line());
+    if (lod >= kLodLabels) {
+        painter->setFont(edgeWeightFont());
+        painter->setPen(QColor(180, 180, 180));
+        painter->drawText(weightRect(), Qt::AlignCenter, weightText);
+    }
+}
+
+void VisualEdge::detach() {
+    if (!sourceNode || !destNode) return;
+    sourceNode->incidentEdges().erase(sourcePos);
+    destNode->incidentEdges().erase(destPos);
+    sourceNode = destNode = nullptr;
 }
 
 void VisualEdge::setHighlighted(bool high) {
@@ -127,6 +264,17 @@ GraphView::GraphView(QWidget *parent) : QGraphicsView(parent) {
     currentMode = Mode::Move;
     nextId = 1;
     tempSourceNode = nullptr;
+    coalesceMoves = false;
+    batched = false;
+    edgeLayer = nullptr;
+    compact = nullptr;
+    connect(this, &GraphView::graphChanged, this, [this]() { dropSnapshot(); });
+    framesPainted = 0;
+    paintNanos = 0;
+    loader = nullptr;
+    nextIdBeforeLoad = 1;
+    loadTimer = new QTimer(this);
+    connect(loadTimer, &QTimer::timeout, this, &GraphView::addLoadedItems);
     
     setRenderHint(QPainter::Antialiasing);
     setDragMode(QGraphicsView::RubberBandDrag);
@@ -139,6 +287,24 @@ GraphView::GraphView(QWidget *parent) : QGraphicsView(parent) {
     setStyleSheet("border: none; border-radius: 12px; background-color: #1a1c1e;");
 }
 
+void GraphView::paintEvent(QPaintEvent *event) {
+    QElapsedTimer paintTimer;
+    paintTimer.start();
+    QGraphicsView::paintEvent(event);
+    paintNanos += paintTimer.nsecsElapsed();
+    framesPainted++;
+
+    // Averages over about half a second
+    if (!statsClock.isValid()) statsClock.start();
+    qint64 window = statsClock.elapsed();
+    if (window >= 500) {
+        emit frameStats(framesPainted * 1000.0 / window, paintNanos / 1e6 / framesPainted);
+        framesPainted = 0;
+        paintNanos = 0;
+        statsClock.restart();
+    }
+}
+
 void GraphView::drawBackground(QPainter *painter, const QRectF &rect) {
     QGraphicsView::drawBackground(painter, rect);
     
@@ -154,9 +320,26 @@ void GraphView::drawBackground(QPainter *painter, const QRectF &rect) {
 }
 
 GraphView::~GraphView() {
+    if (loader) {
+        clearScene(); // items of the half-loaded graph go before it does
+        loader->discard();
+    }
+    GraphLoader::waitForDiscarded(); // also any canceled earlier
+    delete compact;
     delete graph;
 }
 
+const CompactGraph& GraphView::snapshot(bool withReverse) {
+    if (compact && withReverse && !compact->hasReverse()) dropSnapshot();
+    if (!compact) compact = new CompactGraph(graph, withReverse);
+    return *compact;
+}
+
+void GraphView::dropSnapshot() {
+    delete compact;
+    compact = nullptr;
+}
+
 Graph* GraphView::getGraph() {
     return graph;
 }
@@ -171,30 +354,160 @@ void GraphView::setGraph(Graph* newGraph) {
     }
     
     // Refresh visual items (Clear scene but keep graph data)
-    scene->clear();
+    clearScene();
+    nodeItems.reserve(graph->getVertices().size());
+    if (batched) edgeSlots.reserve(graph->edgeCount());
+    else edgeItems.reserve(graph->edgeCount());
     
     // Reconstruct visual items
     // First pass: Nodes
     for (auto v : graph->getVertices()) {
-        VisualNode* vn = new VisualNode(v, this);
-        scene->addItem(vn);
+        createNodeItem(v);
         if (v->id >= nextId) nextId = v->id + 1;
     }
     
     // Second pass: Edges
     for (auto v : graph->getVertices()) {
-        VisualNode* srcVN = getVisualForVertex(v);
         for (auto e : v->edges) {
-            VisualNode* destVN = getVisualForVertex(e->dest);
-            if (srcVN && destVN) {
-                VisualEdge* ve = new VisualEdge(e, srcVN, destVN);
-                scene->addItem(ve);
-            }
+            createEdgeItem(e);
         }
     }
     emit graphChanged();
 }
 
+Vertex* GraphView::addNode(int id, const std::string& label, int x, int y) {
+    Vertex* v = graph->addVertex(id, label, x, y);
+    if (!v) return nullptr;
+    createNodeItem(v);
+    if (id >= nextId) nextId = id + 1;
+    emit graphChanged();
+    return v;
+}
+
+bool GraphView::removeNode(int id) {
+    Vertex* v = graph->getVertex(id);
+    if (!v) return false;
+    // Edge items first, they point at the node item
+    for (auto e : v->edges) deleteEdgeItem(e);
+    for (auto e : v->incoming) deleteEdgeItem(e);
+    VisualNode* vn = getVisualForVertex(v);
+    if (vn) {
+        if (vn == tempSourceNode) tempSourceNode = nullptr;
+        scene->removeItem(vn);
+        nodeItems.remove(v);
+        delete vn;
+    }
+    graph->removeVertex(id);
+    emit graphChanged();
+    return true;
+}
+
+bool GraphView::moveNode(int id, int x, int y) {
+    Vertex* v = graph->getVertex(id);
+    if (!v) return false;
+    v->x = x;
+    v->y = y;
+    VisualNode* vn = getVisualForVertex(v);
+    if (vn) vn->setPos(x, y); // its edges follow through itemChange
+    emit graphChanged();
+    return true;
+}
+
+Edge* GraphView::addEdge(int srcId, int destId, int weight) {
+    Edge* e = graph->addEdge(graph->getVertex(srcId), graph->getVertex(destId), weight);
+    if (!e) return nullptr;
+    createEdgeItem(e);
+    if (e->twin) createEdgeItem(e->twin);
+    emit graphChanged();
+    return e;
+}
+
+bool GraphView::removeEdge(int srcId, int destId) {
+    Edge* e = graph->getEdge(srcId, destId);
+    if (!e) return false;
+    deleteEdgeItem(e);
+    if (e->twin) deleteEdgeItem(e->twin);
+    graph->removeEdge(e);
+    emit graphChanged();
+    return true;
+}
+
+void GraphView::startLoading(const QString& fileName) {
+    if (loader) cancelLoading();
+    clearScene();
+    tempSourceNode = nullptr;
+    nextIdBeforeLoad = nextId;
+    nextId = 1;
+    setInteractive(false); // nodes on screen belong to the loader until it is done
+
+    loader = new GraphLoader(fileName.toStdString(), &ThreadPool::global());
+    loader->start();
+    loadTimer->start(15);
+    emit loadProgress(0);
+}
+
+void GraphView::addLoadedItems() {
+    // Bounded work per tick so painting and input keep up
+    const int kBatch = 256;
+    Vertex* vertices[kBatch];
+    Edge* edges[kBatch];
+    QElapsedTimer budget;
+    budget.start();
+    bool finished = false;
+    do {
+        finished = loader->isFinished(); // checked first: nothing can be published after it
+        int vertexCount, edgeCount;
+        loader->take(kBatch, vertices, vertexCount, edges, edgeCount);
+        if (vertexCount == 0 && edgeCount == 0) break;
+        finished = false;
+
+        for (int i = 0; i < vertexCount; ++i) {
+            createNodeItem(vertices[i]);
+            if (vertices[i]->id >= nextId) nextId = vertices[i]->id + 1;
+        }
+        for (int i = 0; i < edgeCount; ++i) createEdgeItem(edges[i]);
+    } while (budget.elapsed() < 12);
+
+    emit loadProgress((int)(loader->progress() * 100));
+    if (finished) finishLoading();
+}
+
+void GraphView::finishLoading() {
+    loadTimer->stop();
+    Graph* loaded = loader->takeGraph();
+    QString problems = QString::fromStdString(loader->problems());
+    delete loader;
+    loader = nullptr;
+    setInteractive(true);
+
+    if (loaded) {
+        // The scene already shows it
+        delete graph;
+        graph = loaded;
+        emit graphChanged();
+        emit loadFinished(true, problems);
+    } else {
+        nextId = nextIdBeforeLoad;
+        setGraph(graph);
+        emit loadFinished(false, problems);
+    }
+}
+
+void GraphView::cancelLoading() {
+    if (!loader) return;
+    loadTimer->stop();
+    clearScene(); // before the loader deletes what these items point to
+    // Its worker finishes the slice or batch it is on and deletes the
+    // loader; joining it here would freeze the window until then
+    loader->discard();
+    loader = nullptr;
+    setInteractive(true);
+
+    nextId = nextIdBeforeLoad;
+    setGraph(graph);
+    emit loadCanceled();
+}
+
 void GraphView::setInteractionMode(Mode mode) {
     currentMode = mode;
     tempSourceNode = nullptr;
@@ -218,7 +531,15 @@ void GraphView::mousePressEvent(QMouseEvent *event) {
         int id = nextId++;
         QString label = "Nodo " + QString::number(id);
         emit requestAddNode(id, label, setPos.x(), setPos.y());
-    } 
+    } else if (currentMode == Mode::Delete && event->button() == Qt::LeftButton &&
+               !qgraphicsitem_cast<VisualNode*>(itemAt(event->pos()))) {
+        // Not on a node: the edge under the cursor, if any
+        Edge* e = edgeAt(mapToScene(event->pos()));
+        if (e) {
+            emit requestDeleteEdge(e->source->id, e->dest->id);
+            return;
+        }
+    }
     // Other modes handled by VisualNode::mousePressEvent mostly, 
     // unless clicking on empty space to clear selection.
     QGraphicsView::mousePressEvent(event);
@@ -232,7 +553,12 @@ void GraphView::mouseMoveEvent(QMouseEvent *event) {
         verticalScrollBar()->setValue(verticalScrollBar()->value() - delta.y());
         return;
     }
+    // Dragging a selection moves every selected node in this call; an edge
+    // between two of them is updated once
+    coalesceMoves = true;
     QGraphicsView::mouseMoveEvent(event);
+    coalesceMoves = false;
+    flushEdgeUpdates();
 }
 
 void GraphView::mouseReleaseEvent(QMouseEvent *event) {
@@ -279,60 +605,167 @@ void GraphView::nodeClicked(VisualNode* node) {
 }
 
 void GraphView::nodeMoved(VisualNode* node) {
-    // Update all connected edges
-    // Expensive to iterate all items. optimize by storing edges in VisualNode?
-    QList<QGraphicsItem*> items = scene->items();
-    for(auto item : items) {
-        if(item->type() == VisualEdge::Type) {
-            VisualEdge* ve = static_cast<VisualEdge*>(item);
+    if (edgeLayer) {
+        // The graph's own lists give the edges. While loading they belong
+        // to the loader's thread, but then nodes are only placed once,
+        // before any of their edges exist.
+        if (loader) return;
+        Vertex* v = node->getVertex();
+        for (auto e : v->edges) moveLayerEdge(e);
+        for (auto e : v->incoming) moveLayerEdge(e);
+        return;
+    }
+    // Only the edges attached to this node, O(degree)
+    for (auto ve : node->incidentEdges()) {
+        if (!coalesceMoves) {
             ve->updatePosition();
+        } else if (!ve->updatePending) {
+            ve->updatePending = true;
+            pendingEdges.push_back(ve);
         }
     }
 }
 
+void GraphView::moveLayerEdge(Edge* e) {
+    int* slot = edgeSlots.find(e);
+    if (!slot) return;
+    if (coalesceMoves) edgeLayer->markMoved(*slot);
+    else edgeLayer->refresh(*slot);
+}
+
+void GraphView::flushEdgeUpdates() {
+    for (auto ve : pendingEdges) {
+        ve->updatePending = false;
+        ve->updatePosition();
+    }
+    pendingEdges.clear();
+    if (edgeLayer) edgeLayer->flushMoved();
+}
+
 void GraphView::clear() {
-    scene->clear();
+    clearScene();
     graph->clear();
     nextId = 1;
     emit graphChanged();
 }
 
 VisualNode* GraphView::getVisualForVertex(Vertex* v) {
-    QList<QGraphicsItem*> items = scene->items();
-    for(auto item : items) {
-        if(item->type() == VisualNode::Type) {
-            VisualNode* vn = static_cast<VisualNode*>(item);
-            if(vn->getVertex() == v) return vn;
-        }
-    }
-    return nullptr;
+    VisualNode** vn = nodeItems.find(v);
+    return vn ? *vn : nullptr;
 }
 
 VisualEdge* GraphView::getVisualForEdge(Edge* e) {
-    QList<QGraphicsItem*> items = scene->items();
-    for(auto item : items) {
-        if(item->type() == VisualEdge::Type) {
-            VisualEdge* ve = static_cast<VisualEdge*>(item);
-            if(ve->getEdge() == e) return ve;
+    VisualEdge** ve = edgeItems.find(e);
+    return ve ? *ve : nullptr;
+}
+
+VisualNode* GraphView::createNodeItem(Vertex* v) {
+    // No item cache: the body comes from the shared sprites already, and a
+    // per-item pixmap would only save drawing the label
+    VisualNode* vn = new VisualNode(v, this);
+    scene->addItem(vn);
+    nodeItems.put(v, vn);
+    return vn;
+}
+
+void GraphView::createEdgeItem(Edge* e) {
+    VisualNode* srcVN = getVisualForVertex(e->source);
+    VisualNode* destVN = getVisualForVertex(e->dest);
+    if (!srcVN || !destVN) return;
+    if (edgeLayer) {
+        int* twinSlot = e->twin ? edgeSlots.find(e->twin) : nullptr;
+        edgeSlots.put(e, twinSlot ? *twinSlot : edgeLayer->addEdge(e, srcVN, destVN));
+        return;
+    }
+    VisualEdge* ve = new VisualEdge(e, srcVN, destVN);
+    scene->addItem(ve);
+    edgeItems.put(e, ve);
+}
+
+void GraphView::deleteEdgeItem(Edge* e) {
+    if (edgeLayer) {
+        int* slot = edgeSlots.find(e);
+        if (!slot) return;
+        int removed = *slot;
+        edgeSlots.remove(e);
+        int* twinSlot = e->twin ? edgeSlots.find(e->twin) : nullptr;
+        if (twinSlot && *twinSlot == removed) edgeSlots.remove(e->twin);
+        edgeLayer->removeEdge(removed);
+        return;
+    }
+    VisualEdge* ve = getVisualForEdge(e);
+    if (!ve) return; // e.g. the second list holding a self loop
+    if (ve->updatePending) pendingEdges.remove(ve);
+    ve->detach();
+    scene->removeItem(ve);
+    edgeItems.remove(e);
+    delete ve;
+}
+
+void GraphView::clearScene() {
+    pendingEdges.clear();
+    scene->clear(); // the edge layer goes with it
+    nodeItems.clear();
+    edgeItems.clear();
+    edgeSlots.clear();
+    edgeLayer = nullptr;
+    if (batched) {
+        edgeLayer = new EdgeLayer();
+        scene->addItem(edgeLayer);
+    }
+}
+
+void GraphView::setBatchedEdges(bool on) {
+    if (on == batched || loader) return;
+    batched = on;
+    setGraph(graph);
+}
+
+Edge* GraphView::edgeAt(const QPointF& scenePos) {
+    // A few pixels at the current zoom
+    qreal tolerance = 4 / std::max<qreal>(transform().m11(), 0.001);
+    if (edgeLayer) return edgeLayer->edgeAt(scenePos, tolerance);
+
+    // VisualEdge items, found through the scene's own index
+    QRectF around(scenePos.x() - tolerance, scenePos.y() - tolerance, 2 * tolerance, 2 * tolerance);
+    Edge* best = nullptr;
+    qreal bestDistance = tolerance;
+    for (auto item : scene->items(around)) {
+        if (item->type() != VisualEdge::Type) continue;
+        QLineF line = static_cast<VisualEdge*>(item)->line();
+        qreal dx = line.x2() - line.x1(), dy = line.y2() - line.y1();
+        qreal length = dx * dx + dy * dy;
+        qreal t = length > 0 ? ((scenePos.x() - line.x1()) * dx + (scenePos.y() - line.y1()) * dy) / length : 0;
+        t = std::max<qreal>(0, std::min<qreal>(1, t));
+        qreal distance = std::hypot(line.x1() + t * dx - scenePos.x(), line.y1() + t * dy - scenePos.y());
+        if (distance <= bestDistance) {
+            bestDistance = distance;
+            best = static_cast<VisualEdge*>(item)->getEdge();
         }
     }
-    // Also check reverse edge if undirected? 
-    return nullptr;
+    return best;
 }
 
 void GraphView::highlightPath(LinkedList<Edge*>& path) {
     // Reset all
-    QList<QGraphicsItem*> items = scene->items();
-    for(auto item : items) {
-        if(item->type() == VisualNode::Type) {
-            static_cast<VisualNode*>(item)->setHighlighted(false);
-        } else if(item->type() == VisualEdge::Type) {
-            static_cast<VisualEdge*>(item)->setHighlighted(false);
+    for (auto v : graph->getVertices()) {
+        VisualNode* vn = getVisualForVertex(v);
+        if (vn) vn->setHighlighted(false);
+        if (edgeLayer) continue;
+        for (auto e : v->edges) {
+            VisualEdge* ve = getVisualForEdge(e);
+            if (ve) ve->setHighlighted(false);
         }
     }
+    if (edgeLayer) edgeLayer->clearHighlights();
     
     // Highlight
     for(auto e : path) {
+        if (edgeLayer) {
+            int* slot = edgeSlots.find(e);
+            if (slot) edgeLayer->setHighlighted(*slot, true);
+            continue;
+        }
         VisualEdge* ve = getVisualForEdge(e);
         if(ve) {
             ve->setHighlighted(true);
@@ -430,11 +863,12 @@ void GraphView::applyForceLayout() {
         delete[] idMap;
     }
 
-    for(auto item : scene->items()) {
-        VisualNode* vn = qgraphicsitem_cast<VisualNode*>(item);
-        if(vn) {
-            vn->setPos(vn->getVertex()->x, vn->getVertex()->y);
-            nodeMoved(vn);
-        }
+    dropSnapshot(); // A* reads the coordinates
+    coalesceMoves = true;
+    for(auto v : graph->getVertices()) {
+        VisualNode* vn = getVisualForVertex(v);
+        if(vn) vn->setPos(v->x, v->y); // queues its edges through itemChange
     }
+    coalesceMoves = false;
+    flushEdgeUpdates();
 }
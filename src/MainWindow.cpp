@@ -24,12 +24,10 @@ public:
     MoveNodeCommand(GraphView* v, int id, QPointF oldP, QPointF newP) 
         : view(v), nodeId(id), oldPos(oldP), newPos(newP) {}
     void execute() override { 
-        Vertex* v = view->getGraph()->getVertex(nodeId);
-        if(v) { v->x = newPos.x(); v->y = newPos.y(); view->setGraph(view->getGraph()); }
+        view->moveNode(nodeId, newPos.x(), newPos.y());
     }
     void undo() override {
-        Vertex* v = view->getGraph()->getVertex(nodeId);
-        if(v) { v->x = oldPos.x(); v->y = oldPos.y(); view->setGraph(view->getGraph()); }
+        view->moveNode(nodeId, oldPos.x(), oldPos.y());
     }
 };
 
@@ -42,13 +40,10 @@ public:
     AddNodeCommand(GraphView* v, int id, std::string l, double xPos, double yPos)
         : view(v), nodeId(id), label(l), x(xPos), y(yPos) {}
     void execute() override {
-        view->getGraph()->addVertex(nodeId, label, x, y);
-        view->setGraph(view->getGraph());
+        view->addNode(nodeId, label, x, y);
     }
     void undo() override {
-        // Need to add removeVertex to Graph
-        view->getGraph()->removeVertex(nodeId);
-        view->setGraph(view->getGraph());
+        view->removeNode(nodeId);
     }
 };
 
@@ -59,12 +54,27 @@ public:
     AddEdgeCommand(GraphView* v, int s, int d, int w)
         : view(v), srcId(s), destId(d), weight(w) {}
     void execute() override {
-        view->getGraph()->addEdge(srcId, destId, weight);
-        view->setGraph(view->getGraph());
+        view->addEdge(srcId, destId, weight);
     }
     void undo() override {
-        view->getGraph()->removeEdge(srcId, destId);
-        view->setGraph(view->getGraph());
+        view->removeEdge(srcId, destId);
+    }
+};
+
+class DeleteEdgeCommand : public Command {
+    GraphView* view;
+    int srcId, destId, weight;
+public:
+    DeleteEdgeCommand(GraphView* v, int s, int d)
+        : view(v), srcId(s), destId(d), weight(1) {
+        Edge* e = view->getGraph()->getEdge(s, d);
+        if(e) weight = e->weight;
+    }
+    void execute() override {
+        view->removeEdge(srcId, destId);
+    }
+    void undo() override {
+        view->addEdge(srcId, destId, weight);
     }
 };
 
@@ -82,26 +92,27 @@ public:
             label = vert->label;
             x = vert->x;
             y = vert->y;
-            // Backup edges
-            for(auto vertex : view->getGraph()->getVertices()) {
-                for(auto e : vertex->edges) {
-                    if(e->source->id == nodeId || e->dest->id == nodeId) {
-                        deletedEdges.push_back({e->source->id, e->dest->id, e->weight});
-                    }
+            // Backup edges: out-edges plus the incoming index, O(degree).
+            // Undirected in-edges are the twins of the out-edges, and self
+            // loops are in both lists, so those are skipped.
+            for(auto e : vert->edges) {
+                deletedEdges.push_back({e->source->id, e->dest->id, e->weight});
+            }
+            if(view->getGraph()->isDirected()) {
+                for(auto e : vert->incoming) {
+                    if(e->source != vert) deletedEdges.push_back({e->source->id, e->dest->id, e->weight});
                 }
             }
         }
     }
     void execute() override {
-        view->getGraph()->removeVertex(nodeId);
-        view->setGraph(view->getGraph());
+        view->removeNode(nodeId);
     }
     void undo() override {
-        view->getGraph()->addVertex(nodeId, label, x, y);
+        view->addNode(nodeId, label, x, y);
         for(auto& ei : deletedEdges) {
-            view->getGraph()->addEdge(ei.src, ei.dst, ei.weight);
+            view->addEdge(ei.src, ei.dst, ei.weight);
         }
-        view->setGraph(view->getGraph());
     }
 };
 
@@ -142,12 +153,30 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
     connect(graphView, &GraphView::requestAddNode, this, &MainWindow::handleRequestAddNode, Qt::QueuedConnection);
     connect(graphView, &GraphView::requestAddEdge, this, &MainWindow::handleRequestAddEdge, Qt::QueuedConnection);
     connect(graphView, &GraphView::requestDeleteVertex, this, &MainWindow::handleRequestDeleteVertex, Qt::QueuedConnection);
+    connect(graphView, &GraphView::requestDeleteEdge, this, &MainWindow::handleRequestDeleteEdge, Qt::QueuedConnection);
 
     createActions();
     createToolBar();
     
     statusLabel = new QLabel("Listo");
     statusBar()->addWidget(statusLabel);
+    frameStatsLabel = new QLabel(this);
+    statusBar()->addPermanentWidget(frameStatsLabel);
+    connect(graphView, &GraphView::frameStats, this, &MainWindow::handleFrameStats);
+
+    // Shown only while a file loads in the background
+    loadProgressBar = new QProgressBar(this);
+    loadProgressBar->setRange(0, 100);
+    loadProgressBar->setMaximumWidth(200);
+    loadProgressBar->hide();
+    cancelLoadButton = new QPushButton("Cancelar", this);
+    cancelLoadButton->hide();
+    statusBar()->addPermanentWidget(loadProgressBar);
+    statusBar()->addPermanentWidget(cancelLoadButton);
+    connect(graphView, &GraphView::loadProgress, loadProgressBar, &QProgressBar::setValue);
+    connect(graphView, &GraphView::loadFinished, this, &MainWindow::handleLoadFinished);
+    connect(graphView, &GraphView::loadCanceled, this, &MainWindow::handleLoadCanceled);
+    connect(cancelLoadButton, &QPushButton::clicked, graphView, &GraphView::cancelLoading);
     
     connect(graphView, &GraphView::graphChanged, this, &MainWindow::updateStats);
     updateStats();
@@ -157,15 +186,16 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow(parent) {
 
 void MainWindow::updateStats() {
     int vCount = graphView->getGraph()->getVertices().size();
-    int eCount = 0;
-    for (auto v : graphView->getGraph()->getVertices()) {
-        eCount += v->edges.size();
-    }
+    int eCount = graphView->getGraph()->edgeCount();
     
     QString stats = QString("Vértices: %1\nAristas: %2").arg(vCount).arg(eCount);
     statsLabel->setText(stats);
 }
 
+void MainWindow::handleFrameStats(double fps, double paintMs) {
+    frameStatsLabel->setText(QString("%1 FPS · dibujo %2 ms").arg(fps, 0, 'f', 0).arg(paintMs, 0, 'f', 1));
+}
+
 void MainWindow::applyStyle() {
     this->setStyleSheet(R"(
         QMainWindow {
@@ -278,6 +308,11 @@ void MainWindow::createActions() {
 
     actionForceLayout = new QAction("Organizar Automáticamente", this);
     connect(actionForceLayout, &QAction::triggered, this, &MainWindow::runForceLayout);
+
+    // One item for all the edges, for very large graphs
+    actionBatchedEdges = new QAction("Aristas en Lote", this);
+    actionBatchedEdges->setCheckable(true);
+    connect(actionBatchedEdges, &QAction::toggled, graphView, &GraphView::setBatchedEdges);
     
     // Grouping
     QActionGroup* modeGroup = new QActionGroup(this);
@@ -330,6 +365,7 @@ void MainWindow::createToolBar() {
     editToolBar->addAction(actionUndo);
     editToolBar->addAction(actionRedo);
     editToolBar->addAction(actionForceLayout);
+    editToolBar->addAction(actionBatchedEdges);
     
     QToolBar* algoToolBar = addToolBar("Algoritmos");
     algoToolBar->addAction(actionPathMatrix);
@@ -354,23 +390,69 @@ void MainWindow::newGraph() {
 }
 
 void MainWindow::loadGraph() {
-    QString fileName = QFileDialog::getOpenFileName(this, "Cargar Grafo", "", "Archivos de Grafo (*.graph);;Todos los archivos (*)");
+    QString fileName = QFileDialog::getOpenFileName(this, "Cargar Grafo", "", "Archivos de Grafo (*.graph *.graphb *.graphz);;Todos los archivos (*)");
     if (fileName.isEmpty()) return;
     
-    Graph* newGraph = FileController::loadGraph(fileName.toStdString());
-    if (newGraph) {
-        graphView->setGraph(newGraph);
-        statusLabel->setText("Cargado " + fileName);
+    loadingFileName = fileName;
+    setEditingEnabled(false);
+    loadProgressBar->setValue(0);
+    loadProgressBar->show();
+    cancelLoadButton->show();
+    statusLabel->setText("Cargando " + fileName + "...");
+    graphView->startLoading(fileName);
+}
+
+void MainWindow::handleLoadFinished(bool ok, QString problems) {
+    loadProgressBar->hide();
+    cancelLoadButton->hide();
+    setEditingEnabled(true);
+    if (ok) {
+        statusLabel->setText("Cargado " + loadingFileName);
+        if (!problems.isEmpty()) {
+            QMessageBox::warning(this, "Líneas ignoradas",
+                                 "Algunas líneas del archivo no son válidas y se ignoraron:\n" + problems);
+        }
     } else {
-        QMessageBox::critical(this, "Error", "No se pudo cargar el archivo.");
+        statusLabel->setText("Listo");
+        QString message = "No se pudo cargar el archivo.";
+        if (!problems.isEmpty()) message += "\n" + problems;
+        QMessageBox::critical(this, "Error", message);
     }
 }
 
+void MainWindow::handleLoadCanceled() {
+    loadProgressBar->hide();
+    cancelLoadButton->hide();
+    setEditingEnabled(true);
+    statusLabel->setText("Carga cancelada.");
+}
+
+// Everything that reads or changes the graph is off while a load runs
+void MainWindow::setEditingEnabled(bool enabled) {
+    QAction* actions[] = {actionNew, actionLoad, actionSave, actionExportPNG, actionAddNode, actionAddEdge,
+                          actionMove, actionDelete, actionForceLayout, actionBatchedEdges, actionPathMatrix, actionDijkstra,
+                          actionFloyd, actionMST, actionDetectCycles, actionCentrality, actionUndo, actionRedo};
+    for (QAction* action : actions) action->setEnabled(enabled);
+}
+
 void MainWindow::saveGraph() {
-    QString fileName = QFileDialog::getSaveFileName(this, "Guardar Grafo", "", "Archivos de Grafo (*.graph);;Todos los archivos (*)");
+    const QString textFilter = "Archivos de Grafo (*.graph)";
+    const QString binaryFilter = "Grafo binario (*.graphb)";
+    const QString compressedFilter = "Grafo comprimido (*.graphz)";
+    QString selectedFilter;
+    QString fileName = QFileDialog::getSaveFileName(this, "Guardar Grafo", "", textFilter + ";;" + binaryFilter + ";;" + compressedFilter + ";;Todos los archivos (*)", &selectedFilter);
     if (fileName.isEmpty()) return;
+
+    GraphFileFormat format = FileController::formatForFileName(fileName.toStdString());
+    if (selectedFilter == binaryFilter) {
+        format = GraphFileFormat::Binary;
+        if (!fileName.endsWith(".graphb")) fileName += ".graphb";
+    } else if (selectedFilter == compressedFilter) {
+        format = GraphFileFormat::Compressed;
+        if (!fileName.endsWith(".graphz")) fileName += ".graphz";
+    }
     
-    if (FileController::saveGraph(graphView->getGraph(), fileName.toStdString())) {
+    if (FileController::saveGraph(graphView->getGraph(), fileName.toStdString(), format)) {
         statusLabel->setText("Guardado en " + fileName);
     } else {
         QMessageBox::critical(this, "Error", "No se pudo guardar el archivo.");
@@ -414,18 +496,18 @@ void MainWindow::runForceLayout() {
 void MainWindow::runPathMatrix() {
     Graph* g = graphView->getGraph();
     int size;
-    bool** matrix = GraphAlgorithms::getPathMatrix(g, size);
+    BitMatrix* matrix = GraphAlgorithms::getPathMatrix(g, size);
     
     QString result = "Matriz de Caminos (Alcanzabilidad):\n";
     for(int i=0; i<size; ++i) {
         for(int j=0; j<size; ++j) {
-            result += (matrix[i][j] ? "1 " : "0 ");
+            result += (matrix->get(i, j) ? "1 " : "0 ");
         }
         result += "\n";
     }
     
     QMessageBox::information(this, "Matriz de Caminos", result);
-    GraphAlgorithms::freeMatrix(matrix, size);
+    delete matrix;
 }
 
 void MainWindow::runDijkstra() {
@@ -434,20 +516,31 @@ void MainWindow::runDijkstra() {
     if(!ok) return;
     int endId = QInputDialog::getInt(this, "Dijkstra", "ID del Nodo Final:", 0, 0, 1000, 1, &ok);
     if(!ok) return;
-    
-    Graph* g = graphView->getGraph();
-    LinkedList<Edge*> path = GraphAlgorithms::getShortestPathDijkstra(g, startId, endId);
-    
+
+    QStringList modes;
+    modes << "Dijkstra" << "Dijkstra bidireccional" << "A* (distancia euclidiana)";
+    QString mode = QInputDialog::getItem(this, "Dijkstra", "Modo de búsqueda:", modes, 0, false, &ok);
+    if(!ok) return;
+
+    // The view keeps the snapshot between queries until the graph changes
+    const CompactGraph& g = graphView->snapshot(mode == modes[1]);
+    int settled = 0;
+    LinkedList<Edge*> path = (mode == modes[1]) ? GraphAlgorithms::getShortestPathBidirectional(g, startId, endId, &settled)
+                           : (mode == modes[2]) ? GraphAlgorithms::getShortestPathAStar(g, startId, endId, &settled)
+                           : GraphAlgorithms::getShortestPathDijkstra(g, startId, endId, &settled);
+
     if (path.size() == 0) {
-        QMessageBox::information(this, "Dijkstra", "No se encontró camino o hubo un error.");
+        QMessageBox::information(this, mode, "No se encontró camino o hubo un error.");
     } else {
         graphView->highlightPath(path);
         QString msg = "Camino más corto:\n";
         for (auto e : path) {
             msg += QString::number(e->source->id) + " -> " + QString::number(e->dest->id) + " (" + QString::number(e->weight) + ")\n";
         }
-        QMessageBox::information(this, "Resultado de Dijkstra", msg);
+        msg += "\nNodos asentados: " + QString::number(settled);
+        QMessageBox::information(this, "Resultado de " + mode, msg);
     }
+    statusLabel->setText(mode + ": " + QString::number(settled) + " nodos asentados.");
 }
 
 void MainWindow::runFloydWarshall() {
@@ -492,17 +585,40 @@ void MainWindow::runMST() {
 }
 
 void MainWindow::runCycleDetection() {
-    if (GraphAlgorithms::hasCycles(graphView->getGraph())) {
-        QMessageBox::warning(this, "Detección de Ciclos", "¡Se han detectado ciclos en el grafo!");
+    Graph* g = graphView->getGraph();
+    LinkedList<Edge*> cycle = GraphAlgorithms::findCycle(g);
+
+    QString components;
+    if (g->isDirected()) {
+        int size, count;
+        int* idMap;
+        int* comp = GraphAlgorithms::getStronglyConnectedComponents(g, idMap, size, count);
+        components = "\nComponentes fuertemente conexas: " + QString::number(count);
+        delete[] comp;
+        delete[] idMap;
+    }
+
+    if (!cycle.isEmpty()) {
+        graphView->highlightPath(cycle);
+        QString msg = "¡Se han detectado ciclos en el grafo!\nCiclo resaltado: ";
+        for (auto e : cycle) msg += QString::number(e->source->id) + " -> ";
+        msg += QString::number(cycle.back()->dest->id);
+        QMessageBox::warning(this, "Detección de Ciclos", msg + components);
     } else {
-        QMessageBox::information(this, "Detección de Ciclos", "El grafo no contiene ciclos.");
+        QMessageBox::information(this, "Detección de Ciclos", "El grafo no contiene ciclos." + components);
     }
 }
 
 void MainWindow::runCentralityAnalysis() {
     int size;
     int* idMap;
-    double* closeness = GraphAlgorithms::getClosenessCentrality(graphView->getGraph(), idMap, size);
+    // Very large graphs get the sampled estimate instead of one search per node
+    const int exactLimit = 20000;
+    const int samples = 512;
+    Graph* g = graphView->getGraph();
+    bool sampled = (int)g->getVertices().size() > exactLimit;
+    double bound = 0;
+    double* closeness = GraphAlgorithms::getClosenessCentrality(g, idMap, size, sampled ? samples : 0, &bound);
     
     if (!closeness) {
         QMessageBox::warning(this, "Centralidad", "No se pudo realizar el análisis.");
@@ -510,6 +626,10 @@ void MainWindow::runCentralityAnalysis() {
     }
 
     QString report = "Centralidad de Cercanía (Closeness):\n\n";
+    if (sampled) {
+        report = QString("Centralidad de Cercanía (estimada con %1 pivotes, error <= %2 x diámetro):\n\n")
+                     .arg(samples).arg(bound, 0, 'f', 3);
+    }
     for (int i = 0; i < size; ++i) {
         Vertex* v = graphView->getGraph()->getVertex(idMap[i]);
         if (v) report += QString("%1: %2\n").arg(QString::fromStdString(v->label)).arg(closeness[i], 0, 'f', 4);
@@ -567,6 +687,12 @@ void MainWindow::handleRequestDeleteVertex(int id) {
     cmd->execute();
 }
 
+void MainWindow::handleRequestDeleteEdge(int srcId, int destId) {
+    auto* cmd = new DeleteEdgeCommand(graphView, srcId, destId);
+    addCommand(cmd);
+    cmd->execute();
+}
+
 
 void MainWindow::exportSVG() {
      QMessageBox::information(this, "Exportar", "La exportación a SVG no está disponible en este entorno (Falta QtSvg).");
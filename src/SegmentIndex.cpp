@@ -0,0 +1,189 @@
+#include "SegmentIndex.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// Cell coordinates are kept within +-2^28 so that level and both coordinates
+// pack into one 64-bit key
+static const int kCellLimit = 1 << 28;
+
+static int cellCoordinate(double value, double size) {
+    double c = std::floor(value / size);
+    if (c < -kCellLimit) return -kCellLimit;
+    if (c > kCellLimit - 1) return kCellLimit - 1;
+    return (int)c;
+}
+
+SegmentIndex::SegmentIndex(float cellSize)
+    : cellSize(cellSize > 0 ? cellSize : 64.0f), coords(nullptr), next(nullptr), prev(nullptr), cellOf(nullptr),
+      idCount(0), capacity(0), live(0), freeHead(-1) {
+    clear();
+}
+
+SegmentIndex::~SegmentIndex() {
+    delete[] coords;
+    delete[] next;
+    delete[] prev;
+    delete[] cellOf;
+}
+
+void SegmentIndex::clear() {
+    idCount = 0;
+    live = 0;
+    freeHead = -1;
+    heads.clear();
+    for (int level = 0; level < kLevels; ++level) {
+        levelSize[level] = 0;
+        used[level] = CellRange{1, 1, 0, 0};
+    }
+}
+
+uint64_t SegmentIndex::cellKey(int level, int cx, int cy) {
+    const uint64_t mask = ((uint64_t)1 << 29) - 1;
+    return ((uint64_t)level << 58) | (((uint64_t)(cx + kCellLimit) & mask) << 29) | ((uint64_t)(cy + kCellLimit) & mask);
+}
+
+uint64_t SegmentIndex::keyFor(const float* s, int& level) const {
+    double extent = std::max(std::fabs((double)s[2] - s[0]), std::fabs((double)s[3] - s[1]));
+    double size = cellSize;
+    level = 0;
+    while (size < extent && level < kLevels - 1) {
+        size *= 2;
+        level++;
+    }
+    int cx = cellCoordinate(((double)s[0] + s[2]) / 2, size);
+    int cy = cellCoordinate(((double)s[1] + s[3]) / 2, size);
+    return cellKey(level, cx, cy);
+}
+
+SegmentIndex::CellRange SegmentIndex::cellsAround(int level, float left, float top, float right,
+                                                  float bottom) const {
+    if (levelSize[level] == 0) return CellRange{1, 1, 0, 0};
+    double size = std::ldexp((double)cellSize, level);
+    double margin = size / 2; // how far a box can stick out of its cell
+    const CellRange& u = used[level];
+    CellRange r;
+    r.x0 = std::max(cellCoordinate(left - margin, size), u.x0);
+    r.y0 = std::max(cellCoordinate(top - margin, size), u.y0);
+    r.x1 = std::min(cellCoordinate(right + margin, size), u.x1);
+    r.y1 = std::min(cellCoordinate(bottom + margin, size), u.y1);
+    return r;
+}
+
+void SegmentIndex::grow() {
+    int bigger = capacity == 0 ? 1024 : capacity * 2;
+    float* newCoords = new float[(size_t)bigger * 4];
+    int* newNext = new int[bigger];
+    int* newPrev = new int[bigger];
+    uint64_t* newCellOf = new uint64_t[bigger];
+    if (idCount) {
+        std::memcpy(newCoords, coords, (size_t)idCount * 4 * sizeof(float));
+        std::memcpy(newNext, next, idCount * sizeof(int));
+        std::memcpy(newPrev, prev, idCount * sizeof(int));
+        std::memcpy(newCellOf, cellOf, idCount * sizeof(uint64_t));
+    }
+    delete[] coords;
+    delete[] next;
+    delete[] prev;
+    delete[] cellOf;
+    coords = newCoords;
+    next = newNext;
+    prev = newPrev;
+    cellOf = newCellOf;
+    capacity = bigger;
+}
+
+void SegmentIndex::link(int id, uint64_t key, int level) {
+    int* head = heads.find(key);
+    prev[id] = -1;
+    next[id] = head ? *head : -1;
+    if (head) {
+        prev[*head] = id;
+        *head = id;
+    } else {
+        heads.insert(key, id);
+    }
+    cellOf[id] = key;
+
+    const uint64_t mask = ((uint64_t)1 << 29) - 1;
+    int cx = (int)((key >> 29) & mask) - kCellLimit;
+    int cy = (int)(key & mask) - kCellLimit;
+    CellRange& u = used[level];
+    if (levelSize[level]++ == 0 && u.x0 > u.x1) u = CellRange{cx, cy, cx, cy};
+    u.x0 = std::min(u.x0, cx);
+    u.y0 = std::min(u.y0, cy);
+    u.x1 = std::max(u.x1, cx);
+    u.y1 = std::max(u.y1, cy);
+}
+
+void SegmentIndex::unlink(int id) {
+    uint64_t key = cellOf[id];
+    if (prev[id] != -1) next[prev[id]] = next[id];
+    else if (next[id] != -1) heads.put(key, next[id]);
+    else heads.remove(key);
+    if (next[id] != -1) prev[next[id]] = prev[id];
+    levelSize[key >> 58]--;
+}
+
+int SegmentIndex::add(float x1, float y1, float x2, float y2) {
+    int id;
+    if (freeHead != -1) {
+        id = freeHead;
+        freeHead = next[id];
+    } else {
+        if (idCount == capacity) grow();
+        id = idCount++;
+    }
+    float* s = coords + 4 * id;
+    s[0] = x1;
+    s[1] = y1;
+    s[2] = x2;
+    s[3] = y2;
+    int level;
+    uint64_t key = keyFor(s, level);
+    link(id, key, level);
+    live++;
+    return id;
+}
+
+void SegmentIndex::move(int id, float x1, float y1, float x2, float y2) {
+    float* s = coords + 4 * id;
+    s[0] = x1;
+    s[1] = y1;
+    s[2] = x2;
+    s[3] = y2;
+    int level;
+    uint64_t key = keyFor(s, level);
+    if (key == cellOf[id]) return; // still the same cell
+    unlink(id);
+    link(id, key, level);
+}
+
+void SegmentIndex::remove(int id) {
+    unlink(id);
+    float* s = coords + 4 * id;
+    s[0] = s[1] = s[2] = s[3] = std::nanf("");
+    cellOf[id] = kFree;
+    next[id] = freeHead;
+    freeHead = id;
+    live--;
+}
+
+int SegmentIndex::nearest(float x, float y, float tolerance) const {
+    int best = -1;
+    double bestDistance = (double)tolerance * tolerance;
+    query(x - tolerance, y - tolerance, x + tolerance, y + tolerance, [&](int id) {
+        const float* s = segment(id);
+        double dx = (double)s[2] - s[0], dy = (double)s[3] - s[1];
+        double length = dx * dx + dy * dy;
+        double t = length > 0 ? ((x - s[0]) * dx + (y - s[1]) * dy) / length : 0;
+        t = std::max(0.0, std::min(1.0, t));
+        double px = s[0] + t * dx - x, py = s[1] + t * dy - y;
+        double distance = px * px + py * py;
+        if (distance <= bestDistance) {
+            bestDistance = distance;
+            best = id;
+        }
+    });
+    return best;
+}
@@ -0,0 +1,139 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(int size)
+    : jobFn(nullptr), jobCtx(nullptr), jobGrain(1), pending(0),
+      generation(0), activeWorkers(0), stopping(false)
+{
+    if (size <= 0) size = (int)std::thread::hardware_concurrency();
+    if (size <= 0) size = 1;
+    workerCount = size;
+
+    queues = new WorkQueue[workerCount];
+    threads = new std::thread[workerCount > 1 ? workerCount - 1 : 1];
+    for (int i = 0; i < workerCount - 1; ++i) {
+        threads[i] = std::thread(&ThreadPool::workerMain, this, i + 1);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        stopping = true;
+    }
+    startCv.notify_all();
+    for (int i = 0; i < workerCount - 1; ++i) threads[i].join();
+    delete[] threads;
+    delete[] queues;
+}
+
+ThreadPool& ThreadPool::global() {
+    static ThreadPool pool;
+    return pool;
+}
+
+void ThreadPool::run(int begin, int end, int grain, RangeFn fn, void* ctx) {
+    if (end <= begin) return;
+    if (grain < 1) grain = 1;
+
+    // Not worth waking anybody up
+    if (workerCount == 1 || end - begin <= grain) {
+        fn(ctx, begin, end, 0);
+        return;
+    }
+
+    std::lock_guard<std::mutex> runGuard(runLock);
+    jobFn = fn;
+    jobCtx = ctx;
+    jobGrain = grain;
+    pending.store(end - begin);
+
+    // Equal initial slices; stealing evens out whatever imbalance is left
+    long long total = end - begin;
+    for (int w = 0; w < workerCount; ++w) {
+        int lo = begin + (int)(total * w / workerCount);
+        int hi = begin + (int)(total * (w + 1) / workerCount);
+        if (hi > lo) pushLocal(w, {lo, hi});
+    }
+
+    {
+        std::lock_guard<std::mutex> guard(stateLock);
+        generation++;
+        activeWorkers = workerCount - 1;
+    }
+    startCv.notify_all();
+
+    work(0);
+
+    // ctx lives on the caller's stack: wait until no worker can touch it
+    std::unique_lock<std::mutex> guard(stateLock);
+    doneCv.wait(guard, [this] { return activeWorkers == 0; });
+}
+
+void ThreadPool::workerMain(int id) {
+    unsigned long long seen = 0;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> guard(stateLock);
+            startCv.wait(guard, [&] { return stopping || generation != seen; });
+            if (stopping) return;
+            seen = generation;
+        }
+
+        work(id);
+
+        std::lock_guard<std::mutex> guard(stateLock);
+        if (--activeWorkers == 0) doneCv.notify_all();
+    }
+}
+
+void ThreadPool::work(int id) {
+    Range r;
+    while (pending.load() > 0) {
+        if (!popLocal(id, r) && !steal(id, r)) {
+            std::this_thread::yield();
+            continue;
+        }
+        // Lazy splitting: leave the upper half for thieves
+        while (r.hi - r.lo > jobGrain) {
+            int mid = r.lo + (r.hi - r.lo) / 2;
+            pushLocal(id, {mid, r.hi});
+            r.hi = mid;
+        }
+        jobFn(jobCtx, r.lo, r.hi, id);
+        pending.fetch_sub(r.hi - r.lo);
+    }
+}
+
+void ThreadPool::pushLocal(int id, Range r) {
+    WorkQueue& q = queues[id];
+    std::lock_guard<std::mutex> guard(q.lock);
+    if (q.tail == WorkQueue::kCapacity) {
+        // Slide the live part down over the slots thieves already emptied
+        int live = q.tail - q.head;
+        for (int i = 0; i < live; ++i) q.items[i] = q.items[q.head + i];
+        q.head = 0;
+        q.tail = live;
+    }
+    q.items[q.tail++] = r;
+}
+
+bool ThreadPool::popLocal(int id, Range& r) {
+    WorkQueue& q = queues[id];
+    std::lock_guard<std::mutex> guard(q.lock);
+    if (q.tail == q.head) return false;
+    r = q.items[--q.tail];
+    if (q.tail == q.head) q.head = q.tail = 0;
+    return true;
+}
+
+bool ThreadPool::steal(int id, Range& r) {
+    for (int k = 1; k < workerCount; ++k) {
+        WorkQueue& q = queues[(id + k) % workerCount];
+        std::lock_guard<std::mutex> guard(q.lock);
+        if (q.tail == q.head) continue;
+        r = q.items[q.head++];
+        if (q.tail == q.head) q.head = q.tail = 0;
+        return true;
+    }
+    return false;
+}
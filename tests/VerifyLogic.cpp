@@ -2,6 +2,24 @@
 #include <cassert>
 #include "Graph.h"
 #include "GraphAlgorithms.h"
+#include "CompactGraph.h"
+#include "FloydWarshall.h"
+#include "ThreadPool.h"
+#include "UnionFind.h"
+#include "FileController.h"
+#include "BinaryGraphFile.h"
+#include "CompressedGraphFile.h"
+#include "GraphTextParser.h"
+#include "GraphLoader.h"
+#include "HashMap.h"
+#include "SegmentIndex.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
 
 void testBasicGraph() {
     std::cout << "Prueba: Creación básica de grafo... ";
@@ -18,6 +36,28 @@ void testBasicGraph() {
     std::cout << "PASÓ" << std::endl;
 }
 
+void testCompactGraph() {
+    std::cout << "Prueba: Instantánea CSR... ";
+    Graph g(false, true);
+    g.addVertex(10, "A", 0, 0);
+    g.addVertex(20, "B", 0, 0);
+    g.addVertex(30, "C", 0, 0);
+    g.addEdge(10, 20, 4);
+    g.addEdge(20, 30, 6);
+
+    CompactGraph cg(&g);
+    assert(cg.vertexCount() == 3);
+    assert(cg.edgeCount() == 4); // no dirigido: 2 aristas por conexión
+    assert(cg.indexOf(20) == 1 && cg.idAt(1) == 20);
+    assert(cg.indexOf(99) == -1);
+    assert(cg.edgeEnd(0) - cg.edgeBegin(0) == 1);
+    int s = cg.edgeBegin(0);
+    assert(cg.target(s) == 1 && cg.weight(s) == 4);
+    assert(cg.edgeAt(s)->source->id == 10 && cg.edgeAt(s)->dest->id == 20);
+    assert(cg.edgeEnd(1) - cg.edgeBegin(1) == 2);
+    std::cout << "PASÓ" << std::endl;
+}
+
 void testCycles() {
     std::cout << "Prueba: Detección de ciclos... ";
     
@@ -70,11 +110,1129 @@ void testDijkstra() {
     std::cout << "PASÓ" << std::endl;
 }
 
+void testVertexIndex() {
+    std::cout << "Prueba: Índice de vértices por ID... ";
+    Graph g(false, false);
+    for (int i = 0; i < 5000; ++i) {
+        assert(g.addVertex(i * 7, "v", 0, 0) != nullptr);
+    }
+    assert(g.addVertex(21, "dup", 0, 0) == nullptr); // ID repetido
+    assert(g.getVertex(21) != nullptr && g.getVertex(21)->label == "v");
+    assert(g.getVertex(22) == nullptr);
+
+    // Borrar y volver a insertar no debe dejar entradas huérfanas
+    for (int i = 0; i < 5000; i += 2) {
+        assert(g.removeVertex(i * 7));
+    }
+    for (int i = 0; i < 5000; ++i) {
+        assert((g.getVertex(i * 7) != nullptr) == (i % 2 == 1));
+    }
+    assert(g.addVertex(0, "nuevo", 0, 0) != nullptr);
+    assert(g.getVertex(0)->label == "nuevo");
+    assert(g.getVertices().size() == 2501);
+
+    g.clear();
+    assert(g.getVertex(7) == nullptr);
+    std::cout << "PASÓ" << std::endl;
+}
+
+void testShortestPathTree() {
+    std::cout << "Prueba: Árbol de caminos más cortos... ";
+    // Grafo pseudoaleatorio; se compara contra Floyd-Warshall
+    Graph g(true, true);
+    const int n = 60;
+    for (int i = 1; i <= n; ++i) g.addVertex(i, "v", 0, 0);
+    unsigned seed = 12345;
+    for (int k = 0; k < 240; ++k) {
+        seed = seed * 1103515245u + 12345u;
+        int a = 1 + (seed >> 8) % n;
+        seed = seed * 1103515245u + 12345u;
+        int b = 1 + (seed >> 8) % n;
+        g.addEdge(a, b, 1 + (seed >> 20) % 50);
+    }
+
+    int size;
+    int* idMap;
+    int** all = GraphAlgorithms::getAllPairsShortestPaths(&g, size, idMap);
+    for (int src = 0; src < size; src += 7) {
+        ShortestPathTree* tree = GraphAlgorithms::getShortestPathTree(&g, idMap[src]);
+        for (int j = 0; j < size; ++j) {
+            assert(tree->dist[j] == all[src][j]);
+            if (j == src || tree->dist[j] == GraphAlgorithms::INF) continue;
+
+            // El camino reconstruido debe ser contiguo y sumar la distancia
+            LinkedList<Edge*> path = tree->pathTo(idMap[j]);
+            int sum = 0;
+            int at = idMap[src];
+            for (auto e : path) {
+                assert(e->source->id == at);
+                sum += e->weight;
+                at = e->dest->id;
+            }
+            assert(at == idMap[j] && sum == all[src][j]);
+
+            LinkedList<Edge*> direct = GraphAlgorithms::getShortestPathDijkstra(&g, idMap[src], idMap[j]);
+            int directSum = 0;
+            for (auto e : direct) directSum += e->weight;
+            assert(directSum == all[src][j]);
+        }
+        delete tree;
+    }
+    GraphAlgorithms::freeMatrix(all, size);
+    delete[] idMap;
+    std::cout << "PASÓ" << std::endl;
+}
+
+void testPathSearchModes() {
+    std::cout << "Prueba: Dijkstra bidireccional y A*... ";
+    for (int directed = 0; directed <= 1; ++directed) {
+        Graph g(directed == 1, true);
+        const int n = 80;
+        unsigned seed = 777 + directed;
+        auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return (int)(seed >> 8); };
+        for (int i = 1; i <= n; ++i) g.addVertex(i, "v", next() % 500, next() % 500);
+        for (int k = 0; k < 200; ++k) g.addEdge(1 + next() % n, 1 + next() % n, 1 + next() % 40);
+
+        for (int a = 1; a <= n; a += 9) {
+            for (int b = 1; b <= n; b += 4) {
+                int plain = 0, bidir = 0, astar = 0;
+                LinkedList<Edge*> p1 = GraphAlgorithms::getShortestPathDijkstra(&g, a, b, &plain);
+                LinkedList<Edge*> p2 = GraphAlgorithms::getShortestPathBidirectional(&g, a, b, &bidir);
+                LinkedList<Edge*> p3 = GraphAlgorithms::getShortestPathAStar(&g, a, b, &astar);
+                assert(p1.size() == 0 ? p2.size() == 0 && p3.size() == 0 : true);
+
+                int w1 = 0, w2 = 0, w3 = 0;
+                for (auto e : p1) w1 += e->weight;
+                int at = a;
+                for (auto e : p2) { assert(e->source->id == at); w2 += e->weight; at = e->dest->id; }
+                assert(p2.size() == 0 || at == b);
+                at = a;
+                for (auto e : p3) { assert(e->source->id == at); w3 += e->weight; at = e->dest->id; }
+                assert(p3.size() == 0 || at == b);
+                assert(w1 == w2 && w1 == w3);
+                assert(plain > 0 && bidir > 0 && astar > 0);
+            }
+        }
+    }
+    std::cout << "PASÓ" << std::endl;
+}
+
+void testBlockedFloydWarshall() {
+    std::cout << "Prueba: Floyd-Warshall por bloques y SIMD... ";
+    // Tamaño que no es múltiplo del bloque ni del ancho SIMD
+    const int n = 150;
+    const int inf = GraphAlgorithms::INF;
+    int** naive = allocDistanceMatrix(n);
+    int** blocked = allocDistanceMatrix(n);
+    int** simd = allocDistanceMatrix(n);
+    unsigned seed = 99;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            seed = seed * 1103515245u + 12345u;
+            int v = (i == j) ? 0 : ((seed >> 16) % 10 == 0 ? 1 + (seed >> 8) % 90 : inf);
+            naive[i][j] = blocked[i][j] = simd[i][j] = v;
+        }
+    }
+    assert(((unsigned long)naive[1] % 64) == 0); // filas alineadas
+
+    floydWarshallNaive(naive, n, inf);
+    floydWarshallBlocked(blocked, n, inf, MinPlusKernel::Scalar);
+    floydWarshallBlocked(simd, n, inf, bestMinPlusKernel());
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            assert(naive[i][j] == blocked[i][j]);
+            assert(naive[i][j] == simd[i][j]);
+        }
+    }
+    freeDistanceMatrix(naive);
+    freeDistanceMatrix(blocked);
+    freeDistanceMatrix(simd);
+
+    // Distancias grandes: exactas por debajo de inf, y la suma se satura en inf
+    // sin desbordar (cadena 0 -> 1 -> 2 -> 3 con pesos de 4e8)
+    for (int version = 0; version < 3; ++version) {
+        const int m = 4;
+        int** d = allocDistanceMatrix(m);
+        for (int i = 0; i < m; ++i) {
+            for (int j = 0; j < m; ++j) d[i][j] = (i == j) ? 0 : (j == i + 1 ? 400000000 : inf);
+        }
+        if (version == 0) floydWarshallNaive(d, m, inf);
+        else floydWarshallBlocked(d, m, inf, version == 1 ? MinPlusKernel::Scalar : bestMinPlusKernel());
+        assert(d[0][2] == 800000000);
+        assert(d[1][3] == 800000000);
+        assert(d[0][3] == inf);
+        assert(d[3][0] == inf);
+
+        // Un peso negativo no acerca lo inalcanzable: 0 -> 1 (-5), 1 sin salida
+        for (int i = 0; i < m; ++i) {
+            for (int j = 0; j < m; ++j) d[i][j] = (i == j) ? 0 : inf;
+        }
+        d[0][1] = -5;
+        if (version == 0) floydWarshallNaive(d, m, inf);
+        else floydWarshallBlocked(d, m, inf, version == 1 ? MinPlusKernel::Scalar : bestMinPlusKernel());
+        assert(d[0][1] == -5);
+        assert(d[0][2] == inf && d[0][3] == inf);
+        freeDistanceMatrix(d);
+    }
+    std::cout << "PASÓ" << std::endl;
+}
+
+void testThreadPool() {
+    std::cout << "Prueba: Pool de hilos con robo de trabajo... ";
+    ThreadPool pool(4);
+    assert(pool.threadCount() == 4);
+    const int n = 20000;
+    int* hits = new int[n];
+    for (int i = 0; i < n; ++i) hits[i] = 0;
+    std::atomic<long long> sum(0);
+    // Carga desigual: los índices altos cuestan mucho más
+    pool.parallelFor(0, n, 16, [&](int i, int worker) {
+        assert(worker >= 0 && worker < 4);
+        long long local = 0;
+        for (int k = 0; k < i / 100; ++k) local += k % 3;
+        if (local >= 0) hits[i]++;
+        sum += i;
+    });
+    for (int i = 0; i < n; ++i) assert(hits[i] == 1);
+    assert(sum == (long long)n * (n - 1) / 2);
+
+    // Reutilizar el pool varias veces seguidas
+    for (int round = 0; round < 50; ++round) {
+        std::atomic<int> count(0);
+        pool.parallelFor(0, 100, 1, [&](int, int) { count++; });
+        assert(count == 100);
+    }
+    delete[] hits;
+    std::cout << "PASÓ" << std::endl;
+}
+
+void testParallelAllPairs() {
+    std::cout << "Prueba: Caminos más cortos entre todos los pares en paralelo... ";
+    Graph g(true, true);
+    const int n = 150;
+    unsigned seed = 4242;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return (int)(seed >> 8); };
+    for (int i = 1; i <= n; ++i) g.addVertex(i, "v", 0, 0);
+    for (int k = 0; k < 600; ++k) g.addEdge(1 + next() % n, 1 + next() % n, 1 + next() % 70);
+
+    ThreadPool pool(3);
+    int size, sizeF, sizeD;
+    int *idMap, *idMapF, *idMapD;
+    int** serial = GraphAlgorithms::getAllPairsShortestPaths(&g, size, idMap, ApspMode::FloydWarshall, nullptr);
+    int** floyd = GraphAlgorithms::getAllPairsShortestPaths(&g, sizeF, idMapF, ApspMode::FloydWarshall, &pool);
+    int** dijkstra = GraphAlgorithms::getAllPairsShortestPaths(&g, sizeD, idMapD, ApspMode::RepeatedDijkstra, &pool);
+    assert(size == n && sizeF == n && sizeD == n);
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            assert(serial[i][j] == floyd[i][j]);
+            assert(serial[i][j] == dijkstra[i][j]);
+        }
+    }
+    GraphAlgorithms::freeMatrix(serial, size);
+    GraphAlgorithms::freeMatrix(floyd, sizeF);
+    GraphAlgorithms::freeMatrix(dijkstra, sizeD);
+    delete[] idMap;
+    delete[] idMapF;
+    delete[] idMapD;
+    std::cout << "PASÓ" << std::endl;
+}
+
+void testTransitiveClosure() {
+    std::cout << "Prueba: Matriz de caminos (bitset y condensación)... ";
+    unsigned seed = 777;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return (int)(seed >> 8); };
+    for (int directed = 0; directed <= 1; ++directed) {
+        Graph g(directed == 1, false);
+        const int n = 300; // more than one 256-bit row block
+        for (int i = 1; i <= n; ++i) g.addVertex(i, "v", 0, 0);
+        for (int k = 0; k < 330; ++k) g.addEdge(1 + next() % n, 1 + next() % n, 1);
+        g.addEdge(5, 5, 1);
+
+        // Reference: plain Warshall on a bool matrix, same dense order
+        CompactGraph cg(&g);
+        bool* ref = new bool[n * n]();
+        for (int i = 0; i < n; ++i) {
+            for (int s = cg.edgeBegin(i); s < cg.edgeEnd(i); ++s) ref[i * n + cg.target(s)] = true;
+        }
+        for (int k = 0; k < n; ++k)
+            for (int i = 0; i < n; ++i)
+                if (ref[i * n + k])
+                    for (int j = 0; j < n; ++j)
+                        if (ref[k * n + j]) ref[i * n + j] = true;
+
+        int sizeW, sizeC;
+        BitMatrix* warshall = GraphAlgorithms::getPathMatrix(&g, sizeW, ClosureMode::Warshall);
+        BitMatrix* condensed = GraphAlgorithms::getPathMatrix(&g, sizeC, ClosureMode::Condensed);
+        assert(sizeW == n && sizeC == n);
+        for (int i = 0; i < n; ++i) {
+            for (int j = 0; j < n; ++j) {
+                assert(warshall->get(i, j) == ref[i * n + j]);
+                assert(condensed->get(i, j) == ref[i * n + j]);
+            }
+        }
+        assert(warshall->get(cg.indexOf(5), cg.indexOf(5)));
+        delete warshall;
+        delete condensed;
+        delete[] ref;
+    }
+    std::cout << "PASÓ" << std::endl;
+}
+
+static long long totalWeight(LinkedList<Edge*>& edges) {
+    long long total = 0;
+    for (auto e : edges) total += e->weight;
+    return total;
+}
+
+void testSpanningForest() {
+    std::cout << "Prueba: Bosque de expansión mínima (Prim y Kruskal)... ";
+    // Two components: a square with a diagonal, and a triangle
+    Graph g(false, true);
+    for (int i = 1; i <= 7; ++i) g.addVertex(i, "v", 0, 0);
+    g.addEdge(1, 2, 1);
+    g.addEdge(2, 3, 2);
+    g.addEdge(3, 4, 1);
+    g.addEdge(4, 1, 5);
+    g.addEdge(1, 3, 3);
+    g.addEdge(5, 6, 4);
+    g.addEdge(6, 7, 4);
+    g.addEdge(7, 5, 1);
+    LinkedList<Edge*> prim = GraphAlgorithms::getMSTPrim(&g);
+    LinkedList<Edge*> kruskal = GraphAlgorithms::getMSTKruskal(&g);
+    assert(prim.size() == 5 && kruskal.size() == 5);
+    assert(totalWeight(prim) == 9 && totalWeight(kruskal) == 9);
+
+    // Random graphs with isolated parts, directed and undirected
+    unsigned seed = 99;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return (int)(seed >> 8); };
+    for (int directed = 0; directed <= 1; ++directed) {
+        Graph r(directed == 1, true);
+        const int n = 400;
+        for (int i = 1; i <= n; ++i) r.addVertex(i, "v", 0, 0);
+        UnionFind components(n);
+        for (int k = 0; k < 500; ++k) {
+            int a = 1 + next() % n, b = 1 + next() % n;
+            if (r.addEdge(a, b, next() % 50 - 5)) components.unite(a - 1, b - 1);
+        }
+        LinkedList<Edge*> p = GraphAlgorithms::getMSTPrim(&r);
+        LinkedList<Edge*> k = GraphAlgorithms::getMSTKruskal(&r);
+        assert((int)p.size() == n - components.setCount());
+        assert((int)k.size() == n - components.setCount());
+        assert(totalWeight(p) == totalWeight(k));
+    }
+    std::cout << "PASÓ" << std::endl;
+}
+
+// Checks that the edges chain into a closed walk
+static bool isClosedCycle(LinkedList<Edge*>& cycle) {
+    if (cycle.isEmpty()) return false;
+    Vertex* start = nullptr;
+    Vertex* at = nullptr;
+    for (auto e : cycle) {
+        if (!start) start = e->source;
+        else if (e->source != at) return false;
+        at = e->dest;
+    }
+    return at == start;
+}
+
+void testCycleExtraction() {
+    std::cout << "Prueba: Ciclo encontrado, componentes fuertes y DFS iterativo... ";
+    // 1 -> 2 -> 3 -> 4 -> 2, and 5 alone
+    Graph gd(true, false);
+    for (int i = 1; i <= 5; ++i) gd.addVertex(i, "v", 0, 0);
+    gd.addEdge(1, 2, 0);
+    gd.addEdge(2, 3, 0);
+    gd.addEdge(3, 4, 0);
+    gd.addEdge(4, 2, 0);
+    LinkedList<Edge*> cycle = GraphAlgorithms::findCycle(&gd);
+    assert(cycle.size() == 3 && isClosedCycle(cycle));
+
+    int size, count;
+    int* idMap;
+    int* comp = GraphAlgorithms::getStronglyConnectedComponents(&gd, idMap, size, count);
+    assert(size == 5 && count == 3);
+    int c[6];
+    for (int i = 0; i < size; ++i) c[idMap[i]] = comp[i];
+    assert(c[2] == c[3] && c[3] == c[4]);
+    assert(c[1] != c[2] && c[5] != c[2] && c[1] != c[5]);
+    assert(c[1] > c[2]); // reverse topological order
+    delete[] comp;
+    delete[] idMap;
+
+    // Undirected: a tree has no cycle, one more edge closes one
+    Graph gu(false, false);
+    for (int i = 1; i <= 6; ++i) gu.addVertex(i, "v", 0, 0);
+    gu.addEdge(1, 2, 0);
+    gu.addEdge(2, 3, 0);
+    gu.addEdge(2, 4, 0);
+    gu.addEdge(4, 5, 0);
+    assert(GraphAlgorithms::findCycle(&gu).isEmpty());
+    gu.addEdge(5, 3, 0);
+    LinkedList<Edge*> ucycle = GraphAlgorithms::findCycle(&gu);
+    assert(ucycle.size() == 4 && isClosedCycle(ucycle));
+
+    // Self loop counts
+    Graph loop(false, false);
+    loop.addVertex(1, "1", 0, 0);
+    loop.addEdge(1, 1, 0);
+    assert(GraphAlgorithms::hasCycles(&loop));
+
+    // Deep path: the recursive version overflowed the stack here
+    const int n = 1000000;
+    Graph path(true, false);
+    for (int i = 1; i <= n; ++i) path.addVertex(i, "", 0, 0);
+    for (int i = 1; i < n; ++i) path.addEdge(i, i + 1, 0);
+    assert(!GraphAlgorithms::hasCycles(&path));
+    path.addEdge(n, 1, 0);
+    LinkedList<Edge*> whole = GraphAlgorithms::findCycle(&path);
+    assert((int)whole.size() == n && isClosedCycle(whole));
+    comp = GraphAlgorithms::getStronglyConnectedComponents(&path, idMap, size, count);
+    assert(count == 1);
+    delete[] comp;
+    delete[] idMap;
+    std::cout << "PASÓ" << std::endl;
+}
+
+void testClosenessCentrality() {
+    std::cout << "Prueba: Centralidad de cercanía exacta y muestreada... ";
+    ThreadPool pool(3);
+    int size;
+    int* idMap;
+
+    // Unweighted: hop counts, whatever the stored weights are
+    Graph line(false, false);
+    for (int i = 1; i <= 3; ++i) line.addVertex(i, "v", 0, 0);
+    line.addEdge(1, 2, 0);
+    line.addEdge(2, 3, 0);
+    double* c = GraphAlgorithms::getClosenessCentrality(&line, idMap, size, 0, nullptr, &pool);
+    for (int i = 0; i < size; ++i) {
+        double expected = idMap[i] == 2 ? 1.0 : 2.0 / 3.0;
+        assert(std::fabs(c[i] - expected) < 1e-12);
+    }
+    delete[] c;
+    delete[] idMap;
+
+    // Weighted directed: same as reducing the all-pairs matrix
+    Graph g(true, true);
+    const int n = 120;
+    unsigned seed = 31;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return (int)(seed >> 8); };
+    for (int i = 1; i <= n; ++i) g.addVertex(i, "v", 0, 0);
+    for (int k = 0; k < 500; ++k) g.addEdge(1 + next() % n, 1 + next() % n, 1 + next() % 40);
+    int sizeA;
+    int* idMapA;
+    int** all = GraphAlgorithms::getAllPairsShortestPaths(&g, sizeA, idMapA);
+    c = GraphAlgorithms::getClosenessCentrality(&g, idMap, size, 0, nullptr, &pool);
+    assert(size == sizeA);
+    for (int i = 0; i < size; ++i) {
+        assert(idMap[i] == idMapA[i]);
+        double sum = 0;
+        int reachable = 0;
+        for (int j = 0; j < size; ++j) {
+            if (j != i && all[i][j] < GraphAlgorithms::INF) {
+                sum += all[i][j];
+                reachable++;
+            }
+        }
+        assert(std::fabs(c[i] - (sum > 0 ? reachable / sum : 0)) < 1e-12);
+    }
+    GraphAlgorithms::freeMatrix(all, sizeA);
+    delete[] idMapA;
+    delete[] c;
+    delete[] idMap;
+
+    // Sampled on a 30x30 grid (diameter 58): every estimate within the bound
+    Graph grid(false, false);
+    const int side = 30;
+    for (int i = 0; i < side * side; ++i) grid.addVertex(i, "v", 0, 0);
+    for (int r = 0; r < side; ++r) {
+        for (int col = 0; col < side; ++col) {
+            int id = r * side + col;
+            if (col + 1 < side) grid.addEdge(id, id + 1, 1);
+            if (r + 1 < side) grid.addEdge(id, id + side, 1);
+        }
+    }
+    double* exact = GraphAlgorithms::getClosenessCentrality(&grid, idMapA, sizeA, 0, nullptr, &pool);
+    double bound = 0;
+    c = GraphAlgorithms::getClosenessCentrality(&grid, idMap, size, 300, &bound, &pool);
+    assert(bound > 0 && bound < 1);
+    for (int i = 0; i < size; ++i) {
+        assert(std::fabs(1.0 / c[i] - 1.0 / exact[i]) <= bound * 58);
+    }
+    delete[] exact;
+    delete[] idMapA;
+    delete[] c;
+    delete[] idMap;
+    std::cout << "PASÓ" << std::endl;
+}
+
+void testObjectPool() {
+    std::cout << "Prueba: Pool de objetos y liberación en bloque... ";
+    ObjectPool<Edge> pool;
+    Edge* a = pool.create(nullptr, nullptr, 1);
+    Edge* b = pool.create(nullptr, nullptr, 2);
+    assert(pool.liveCount() == 2 && a != b);
+    pool.destroy(a);
+    Edge* c = pool.create(nullptr, nullptr, 3);
+    assert(c == a); // freed slot reused
+    for (int i = 0; i < 10000; ++i) pool.create(nullptr, nullptr, i);
+    assert(pool.liveCount() == 10002 && b->weight == 2 && c->weight == 3);
+    pool.releaseAll();
+    assert(pool.liveCount() == 0 && pool.slabsInUse() == 0);
+
+    // A graph cleared in bulk is still usable afterwards
+    Graph g(false, true);
+    for (int round = 0; round < 3; ++round) {
+        for (int i = 1; i <= 500; ++i) g.addVertex(i, "a label long enough to leave the SSO buffer", 0, 0);
+        for (int i = 1; i < 500; ++i) g.addEdge(i, i + 1, i);
+        g.removeVertex(250);
+        g.removeEdge(1, 2);
+        assert(g.getVertices().size() == 499);
+        assert(g.getVertex(3)->edges.size() == 2);
+        g.clear();
+        assert(g.getVertices().size() == 0 && g.getVertex(1) == nullptr);
+    }
+    std::cout << "PASÓ" << std::endl;
+}
+
+void testUnrolledList() {
+    std::cout << "Prueba: Lista desenrollada... ";
+    UnrolledList<int, 4> list;
+    for (int i = 0; i < 10; ++i) list.push_back(i);
+    assert(list.size() == 10 && list.front() == 0 && list.back() == 9);
+    assert(list.remove(0) && list.remove(5) && list.remove(9) && !list.remove(42));
+    int expected[] = {1, 2, 3, 4, 6, 7, 8};
+    int k = 0;
+    for (int v : list) assert(v == expected[k++]);
+    assert(k == 7 && list.size() == 7 && list.front() == 1 && list.back() == 8);
+
+    // Handles survive other removals; pop_back reuses the tail slots
+    UnrolledList<int, 4>::Position pos = list.push_back(100);
+    list.remove(2);
+    list.erase(pos);
+    assert(list.back() == 8);
+    list.pop_back();
+    list.push_back(200);
+    assert(list.back() == 200 && list.size() == 6);
+
+    // Emptied chunks are unlinked, the list keeps working
+    for (int v : {1, 3, 4, 6, 7, 200}) assert(list.remove(v));
+    assert(list.isEmpty() && list.begin() == list.end());
+    list.push_back(7);
+    assert(list.front() == 7 && list.back() == 7);
+
+    // Pooled chunks and heap copies
+    ObjectPool<UnrolledList<int, 8>::Chunk> chunks;
+    {
+        UnrolledList<int, 8> pooled(&chunks);
+        for (int i = 0; i < 100; ++i) pooled.push_back(i);
+        for (int i = 0; i < 100; i += 2) pooled.remove(i);
+        UnrolledList<int, 8> copy(pooled);
+        assert(copy.size() == 50);
+        long long sum = 0;
+        for (int v : copy) sum += v;
+        assert(sum == 2500);
+    }
+    assert(chunks.liveCount() == 0);
+    std::cout << "PASÓ" << std::endl;
+}
+
+// Every out-edge is in its target's incoming list (at the recorded handle)
+// and vice versa; undirected edges point at a matching twin
+static bool incomingIndexConsistent(Graph& g) {
+    size_t out = 0, in = 0;
+    for (auto v : g.getVertices()) {
+        for (auto e : v->edges) {
+            out++;
+            if (e->source != v || e->outPos.chunk->items[e->outPos.slot] != e) return false;
+            if (e->inPos.chunk->items[e->inPos.slot] != e) return false;
+            if (!g.isDirected() && (!e->twin || e->twin->twin != e || e->twin->source != e->dest)) return false;
+        }
+        for (auto e : v->incoming) {
+            in++;
+            if (e->dest != v) return false;
+        }
+    }
+    return out == in;
+}
+
+void testIncomingIndex() {
+    std::cout << "Prueba: Aristas entrantes y eliminación O(grado)... ";
+    unsigned seed = 2024;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return (int)(seed >> 8); };
+    for (int directed = 0; directed <= 1; ++directed) {
+        Graph g(directed == 1, true);
+        const int n = 200;
+        for (int i = 1; i <= n; ++i) g.addVertex(i, "v", 0, 0);
+        for (int k = 0; k < 1500; ++k) g.addEdge(1 + next() % n, 1 + next() % n, 1);
+        g.addEdge(7, 7, 1);
+        assert(incomingIndexConsistent(g));
+
+        for (int k = 0; k < 400; ++k) {
+            int a = 1 + next() % n, b = 1 + next() % n;
+            bool had = g.getEdge(a, b) != nullptr;
+            assert(g.removeEdge(a, b) == had);
+            assert(g.getEdge(a, b) == nullptr);
+            if (!directed) assert(g.getEdge(b, a) == nullptr);
+        }
+        assert(incomingIndexConsistent(g));
+
+        for (int id = 1; id <= n; id += 3) {
+            assert(g.removeVertex(id));
+            for (auto v : g.getVertices()) {
+                for (auto e : v->edges) assert(e->dest->id != id);
+            }
+        }
+        assert(incomingIndexConsistent(g));
+        assert(g.getVertices().size() == (size_t)(n - (n + 2) / 3));
+        size_t listed = 0;
+        for (auto v : g.getVertices()) listed += v->edges.size();
+        assert(g.edgeCount() == listed);
+
+        // Removed IDs can come back
+        g.addVertex(1, "again", 0, 0);
+        assert(g.addEdge(1, 2, 5) && g.getEdge(1, 2)->weight == 5);
+        assert(incomingIndexConsistent(g));
+    }
+    std::cout << "PASÓ" << std::endl;
+}
+
+// Same vertices (ID, label, position) and the same set of edges
+static long fileSize(const std::string& path) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    return in.is_open() ? (long)in.tellg() : -1;
+}
+
+static bool sameGraph(Graph& a, Graph& b) {
+    if (a.isDirected() != b.isDirected() || a.isWeighted() != b.isWeighted()) return false;
+    if (a.getVertices().size() != b.getVertices().size()) return false;
+    for (auto v : a.getVertices()) {
+        Vertex* w = b.getVertex(v->id);
+        if (!w || w->label != v->label || w->x != v->x || w->y != v->y) return false;
+        if (w->edges.size() != v->edges.size()) return false;
+        for (auto e : v->edges) {
+            Edge* f = b.getEdge(v->id, e->dest->id);
+            if (!f || f->weight != e->weight) return false;
+        }
+    }
+    return true;
+}
+
+void testBinaryFormat() {
+    std::cout << "Prueba: Formato binario .graphb... ";
+    const std::string path = "verify_logic_tmp.graphb";
+    unsigned seed = 8080;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return (int)(seed >> 8); };
+    for (int directed = 0; directed <= 1; ++directed) {
+        Graph g(directed == 1, true);
+        for (int i = 1; i <= 300; ++i) {
+            std::string label = (i % 7 == 0) ? "" : "nodo, " + std::to_string(i * 31);
+            g.addVertex(i * 3, label, next() % 800 - 100, next() % 600);
+        }
+        for (int k = 0; k < 900; ++k) g.addEdge(3 * (1 + next() % 300), 3 * (1 + next() % 300), next() % 100 - 10);
+        g.addEdge(3, 3, 4);
+
+        assert(FileController::formatForFileName(path) == GraphFileFormat::Binary);
+        assert(FileController::saveGraph(&g, path, GraphFileFormat::Binary));
+        Graph* loaded = FileController::loadGraph(path);
+        assert(loaded && sameGraph(g, *loaded) && incomingIndexConsistent(*loaded));
+        delete loaded;
+
+        // Zero-copy view of the same file
+        BinaryGraphFile file;
+        assert(file.open(path));
+        CompactGraph cg(&g);
+        assert(file.vertexCount() == cg.vertexCount() && file.edgeCount() == cg.edgeCount());
+        for (int i = 0; i < cg.vertexCount(); ++i) {
+            assert(file.idAt(i) == cg.idAt(i) && file.labelAt(i) == cg.vertexAt(i)->label);
+            assert(file.offsetArray()[i + 1] == cg.edgeEnd(i));
+        }
+        file.close();
+    }
+
+    // Truncated files are rejected, not read out of bounds
+    {
+        std::ifstream in(path, std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        in.close();
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), bytes.size() / 2);
+    }
+    BinaryGraphFile broken;
+    assert(!broken.open(path) && !broken.error().empty());
+    assert(FileController::loadGraph(path) == nullptr);
+
+    // In-bounds CSRs that no graph produces: a repeated edge, and an
+    // undirected edge stored only one way (toGraph would drop or double them)
+    auto retarget = [&path](int slot, int32_t target) {
+        std::fstream io(path, std::ios::binary | std::ios::in | std::ios::out);
+        BinaryGraphHeader h;
+        io.read((char*)&h, sizeof(h));
+        io.seekp(h.targetsOffset + slot * sizeof(int32_t));
+        io.write((const char*)&target, sizeof(target));
+    };
+    for (int directed = 0; directed <= 1; ++directed) {
+        Graph g(directed == 1, true);
+        for (int i = 1; i <= 3; ++i) g.addVertex(i, "", 0, 0);
+        g.addEdge(1, 2, 5);
+        g.addEdge(1, 3, 6); // rows {1, 2} {} {}, undirected {1, 2} {0} {0}
+        assert(FileController::saveGraph(&g, path, GraphFileFormat::Binary));
+        BinaryGraphFile file;
+        assert(file.open(path));
+        file.close();
+        if (directed) retarget(1, 1); // 1 -> 2 twice
+        else retarget(2, 1);          // 2 -> 1 becomes a 2 -> 2 loop, 1 -> 2 has no reverse
+        assert(!file.open(path) && !file.error().empty());
+        assert(FileController::loadGraph(path) == nullptr);
+    }
+    std::remove(path.c_str());
+    std::cout << "PASÓ" << std::endl;
+}
+
+void testTextParser() {
+    std::cout << "Prueba: Lector de texto .graph... ";
+    const std::string path = "verify_logic_tmp.graph";
+    unsigned seed = 1515;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return (int)(seed >> 8); };
+    for (int directed = 0; directed <= 1; ++directed) {
+        Graph g(directed == 1, directed == 0);
+        for (int i = 1; i <= 200; ++i) g.addVertex(i * 2, "nodo, " + std::to_string(i), next() % 900 - 50, -(next() % 500));
+        for (int k = 0; k < 700; ++k) g.addEdge(2 * (1 + next() % 200), 2 * (1 + next() % 200), next() % 50 - 5);
+        assert(FileController::saveGraph(&g, path));
+        std::string problems = "x";
+        Graph* loaded = FileController::loadGraph(path, &problems);
+        // "TYPE:UNDIRECTED" used to be read as directed
+        assert(loaded && problems.empty() && loaded->isDirected() == g.isDirected() && loaded->isWeighted() == g.isWeighted());
+        assert(sameGraph(g, *loaded) && incomingIndexConsistent(*loaded));
+        delete loaded;
+    }
+
+    // Bad lines are skipped and reported with their line number
+    const std::string text =
+        "TYPE:DIRECTED\r\n"
+        "WEIGHTED:TRUE\r\n"
+        "NODES\r\n"
+        "1,A,10,20\r\n"
+        " 2 , B , 30 , 40 \r\n"
+        "x,C,1,1\r\n"
+        "3,D,5\r\n"
+        "1,dup,0,0\r\n"
+        "\r\n"
+        "EDGES\r\n"
+        "1,2,7\r\n"
+        "2,1,+3\r\n"
+        "1,9,1\r\n"
+        "1,2\r\n"
+        "2,2,5 junk\r\n"
+        "99999999999,1,1\r\n"
+        "2,2,-4";
+    GraphTextParser parser(text.data(), text.size());
+    Graph* g = parser.parse();
+    assert(g->isDirected() && g->isWeighted() && g->getVertices().size() == 2);
+    assert(g->getVertex(2)->label == " B " && g->getVertex(2)->x == 30 && g->getVertex(2)->y == 40);
+    assert(g->getEdge(1, 2)->weight == 7 && g->getEdge(2, 1)->weight == 3 && g->getEdge(2, 2)->weight == -4);
+    int expectedLines[] = {6, 7, 8, 13, 14, 15, 16};
+    assert(parser.errorCount() == 7 && parser.errors().size() == 7);
+    int k = 0;
+    for (auto& e : parser.errors()) assert(e.line == expectedLines[k++] && !e.message.empty());
+    assert(parser.errorSummary().find("línea 13: ") != std::string::npos);
+    delete g;
+
+    // Empty input gives an empty graph
+    GraphTextParser empty(nullptr, 0);
+    g = empty.parse();
+    assert(g->getVertices().isEmpty() && empty.errorCount() == 0);
+    delete g;
+    std::remove(path.c_str());
+    std::cout << "PASÓ" << std::endl;
+}
+
+void testParallelTextParser() {
+    std::cout << "Prueba: Lectura paralela de aristas... ";
+    unsigned seed = 4242;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return (int)(seed >> 8); };
+    std::string text = "TYPE:UNDIRECTED\nWEIGHTED:TRUE\nNODES\n";
+    for (int i = 1; i <= 5000; ++i) text += std::to_string(i) + ",n" + std::to_string(i) + ",1,2\n";
+    text += "EDGES\n";
+    // Over 1 MB of edges with bad lines, unknown endpoints and repeats spread through it
+    for (int k = 0; k < 120000; ++k) {
+        if (k % 9973 == 0) text += "1,oops,3\n";
+        else if (k % 7919 == 0) text += "1,777777,3\n";
+        else if (k % 5003 == 0) text += "\r\n";
+        else text += std::to_string(1 + next() % 5000) + "," + std::to_string(1 + next() % 5000) + "," + std::to_string(next() % 90) + "\n";
+    }
+    text += "3,4,5";
+
+    ThreadPool pool(4);
+    GraphTextParser serial(text.data(), text.size());
+    GraphTextParser parallel(text.data(), text.size());
+    Graph* a = serial.parse();
+    Graph* b = parallel.parse(&pool);
+    assert(sameGraph(*a, *b) && incomingIndexConsistent(*b) && b->getEdge(4, 3));
+    assert(serial.errorCount() > 0 && serial.errorCount() == parallel.errorCount());
+    assert(serial.errorSummary() == parallel.errorSummary());
+    delete a;
+    delete b;
+
+    // A second NODES section after EDGES is only understood by the serial
+    // pass; the parallel one must notice and step aside
+    std::string twoPass = text.substr(0, text.size() - 5) + "NODES\n9001,late,0,0\nEDGES\n9001,1,2\n";
+    GraphTextParser serial2(twoPass.data(), twoPass.size());
+    GraphTextParser parallel2(twoPass.data(), twoPass.size());
+    a = serial2.parse();
+    b = parallel2.parse(&pool);
+    assert(b->getEdge(9001, 1) && sameGraph(*a, *b) && serial2.errorSummary() == parallel2.errorSummary());
+    delete a;
+    delete b;
+
+    // Stopping from the workers ends the parse before the merge
+    struct StopInSlices : GraphTextListener {
+        std::atomic<int> calls{0};
+        void vertexAdded(Vertex*) override {}
+        void edgeAdded(Edge*) override {}
+        bool progress(size_t, size_t) override { return true; }
+        bool workerProgress(size_t, size_t) override { return ++calls < 3; }
+    } stopper;
+    GraphTextParser stoppable(text.data(), text.size());
+    stoppable.setListener(&stopper);
+    b = stoppable.parse(&pool);
+    assert(stoppable.wasStopped() && b->getVertices().size() == 5000 && b->edgeCount() == 0);
+    delete b;
+    std::cout << "PASÓ" << std::endl;
+}
+
+void testTextSave() {
+    std::cout << "Prueba: Guardado de texto sin duplicados y atómico... ";
+    const std::string path = "verify_logic_tmp_save.graph";
+    Graph g(false, true);
+    for (int i = 1; i <= 50; ++i) g.addVertex(i, "v" + std::to_string(i), i * 7, -i);
+    int pairs = 0;
+    for (int i = 1; i <= 50; ++i) {
+        for (int j = i + 1; j <= 50; j += 7) pairs += g.addEdge(j, i, i * j % 13 - 4) ? 1 : 0;
+    }
+    g.addEdge(5, 5, 9);
+    pairs++;
+    assert(FileController::saveGraph(&g, path));
+
+    std::ifstream in(path);
+    std::string line;
+    int edgeLines = -1;
+    while (std::getline(in, line)) {
+        if (edgeLines >= 0) edgeLines++;
+        if (line == "EDGES") edgeLines = 0;
+    }
+    in.close();
+    assert(edgeLines == pairs);
+    Graph* loaded = FileController::loadGraph(path);
+    assert(loaded && sameGraph(g, *loaded) && loaded->getEdge(5, 5));
+    delete loaded;
+
+    // Overwrite in place, and a failed save leaves the old file alone
+    Graph small(true, false);
+    small.addVertex(1, "a", 0, 0);
+    assert(FileController::saveGraph(&small, path));
+    assert(!std::ifstream(path + ".tmp").is_open());
+    assert(!FileController::saveGraph(&g, "no_such_dir/x.graph"));
+    loaded = FileController::loadGraph(path);
+    assert(loaded && sameGraph(small, *loaded));
+    delete loaded;
+
+    // Un archivo ajeno con el nombre "<destino>.tmp" no se pisa
+    {
+        std::ofstream other(path + ".tmp");
+        other << "ajeno";
+    }
+    assert(FileController::saveGraph(&g, path));
+    std::ifstream otherIn(path + ".tmp");
+    std::string otherText;
+    std::getline(otherIn, otherText);
+    assert(otherText == "ajeno");
+    otherIn.close();
+    std::remove((path + ".tmp").c_str());
+    std::remove(path.c_str());
+    std::cout << "PASÓ" << std::endl;
+}
+
+void testCompressedFormat() {
+    std::cout << "Prueba: Formato comprimido .graphz... ";
+    const std::string path = "verify_logic_tmp.graphz";
+    const std::string textPath = "verify_logic_tmp_z.graph";
+    unsigned seed = 3131;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return (int)(seed >> 8); };
+    for (int variant = 0; variant < 3; ++variant) {
+        bool directed = variant != 1;
+        bool weighted = variant != 2;
+        Graph g(directed, weighted);
+        auto id = [](int i) { return 1000 - i * 5 + i % 3; }; // descending, uneven gaps
+        for (int i = 0; i < 400; ++i) {
+            g.addVertex(id(i), i % 5 ? "n,\n" + std::to_string(i) : "", next() % 2000 - 1000, -(next() % 700));
+        }
+        for (int k = 0; k < 2000; ++k) {
+            int u = next() % 400;
+            int v = std::min(399, std::max(0, u + next() % 9 - 4)); // mostly nearby, as the format expects
+            g.addEdge(id(u), id(v), weighted ? next() % 200 - 50 : 1);
+        }
+        g.addEdge(id(0), id(0), weighted ? 7 : 1);
+
+        assert(FileController::formatForFileName(path) == GraphFileFormat::Compressed);
+        assert(FileController::saveGraph(&g, path, GraphFileFormat::Compressed));
+        assert(FileController::saveGraph(&g, textPath));
+        assert(fileSize(path) * 2 < fileSize(textPath));
+        Graph* loaded = FileController::loadGraph(path);
+        assert(loaded && sameGraph(g, *loaded) && incomingIndexConsistent(*loaded));
+        assert(loaded->isDirected() == directed && loaded->isWeighted() == weighted);
+        delete loaded;
+    }
+
+    // Damaged files are rejected with a reason, never read out of bounds
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    CompressedGraphFile file;
+    assert(file.decode(bytes.data(), bytes.size()));
+    for (size_t cut = 0; cut < bytes.size(); cut += 97) assert(!file.decode(bytes.data(), cut) && !file.error().empty());
+    for (size_t pos = sizeof(CompressedGraphHeader); pos < bytes.size(); pos += 13) {
+        std::string damaged = bytes;
+        damaged[pos] = (char)0xff;
+        if (file.decode(damaged.data(), damaged.size())) {
+            Graph* g = file.toGraph(); // may decode to another valid graph, but never a broken one
+            assert(!g || incomingIndexConsistent(*g));
+            delete g;
+        }
+    }
+
+    // Huge deltas are rejected before they are added (signed overflow): a
+    // vertex ID, a first neighbour and a neighbour gap near 2^63, in turn,
+    // in a file that is valid without them
+    auto varint = [](std::string& out, uint64_t v) {
+        for (; v >= 0x80; v >>= 7) out += (char)(v | 0x80);
+        out += (char)v;
+    };
+    const uint64_t nearMax = 0xfffffffffffffffeull; // zigzag(2^63 - 1)
+    for (int hostile = 0; hostile <= 3; ++hostile) {
+        std::string body;
+        for (int i = 0; i < 3; ++i) { // IDs 5, 6, 7 at (0, 0), no labels
+            varint(body, i == 0 ? 10 : (hostile == 0 && i == 1 ? nearMax : 2));
+            body += std::string(3, '\0');
+        }
+        body += '\2';
+        varint(body, 2);                              // 0 -> 1
+        varint(body, hostile == 2 ? nearMax / 2 : 1); // 0 -> 2
+        body += '\1';
+        varint(body, hostile == 1 ? nearMax : 1);     // 1 -> 0
+        body += '\0';
+        CompressedGraphHeader h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, kCompressedGraphMagic, sizeof(h.magic));
+        h.version = kCompressedGraphVersion;
+        h.flags = CompressedGraphDirected;
+        h.vertexCount = 3;
+        h.edgeCount = 3;
+        h.fileSize = sizeof(h) + body.size();
+        std::string crafted = std::string((const char*)&h, sizeof(h)) + body;
+        bool decoded = file.decode(crafted.data(), crafted.size());
+        assert(decoded == (hostile == 3) && (decoded || !file.error().empty()));
+    }
+    std::remove(path.c_str());
+    std::remove(textPath.c_str());
+    std::cout << "PASÓ" << std::endl;
+}
+
+void testGraphLoader() {
+    std::cout << "Prueba: Carga en segundo plano por lotes... ";
+    const std::string path = "verify_logic_tmp_loader.graph";
+    const std::string binaryPath = "verify_logic_tmp_loader.graphb";
+    unsigned seed = 777;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return (int)(seed >> 8); };
+    Graph g(false, true);
+    for (int i = 1; i <= 20000; ++i) g.addVertex(i, "v" + std::to_string(i), next() % 1000, next() % 1000);
+    for (int k = 0; k < 100000; ++k) g.addEdge(1 + next() % 20000, 1 + next() % 20000, 1 + next() % 9); // > 1 MB: parallel EDGES
+    g.addEdge(7, 7, 3);
+    assert(FileController::saveGraph(&g, path));
+    assert(FileController::saveGraph(&g, binaryPath, GraphFileFormat::Binary));
+
+    size_t slots = 0;
+    for (auto v : g.getVertices()) slots += v->edges.size();
+    ThreadPool pool(3);
+    const std::string* paths[] = {&path, &binaryPath};
+    for (const std::string* file : paths) {
+        GraphLoader loader(*file, &pool);
+        loader.start();
+        HashMap<Vertex*, bool> seen;
+        size_t edgeCount = 0;
+        Vertex* vertices[300];
+        Edge* edges[300];
+        // Drain in small batches while the worker is still going, as the view does
+        while (true) {
+            bool finished = loader.isFinished();
+            int nv, ne;
+            loader.take(300, vertices, nv, edges, ne);
+            for (int i = 0; i < nv; ++i) assert(seen.insert(vertices[i], true));
+            for (int i = 0; i < ne; ++i) {
+                assert(seen.contains(edges[i]->source) && seen.contains(edges[i]->dest));
+                edgeCount++;
+            }
+            if (finished && nv == 0 && ne == 0) break;
+        }
+        assert(loader.progress() == 1.0 && !loader.wasCanceled() && loader.problems().empty());
+        Graph* loaded = loader.takeGraph();
+        assert(loaded && sameGraph(g, *loaded) && seen.size() == g.getVertices().size() && edgeCount == slots);
+        delete loaded;
+    }
+
+    // Canceling right away leaves nothing behind
+    for (int round = 0; round < 5; ++round) {
+        GraphLoader loader(path, &pool);
+        loader.start();
+        loader.cancel();
+        while (!loader.isFinished()) {
+            int nv, ne;
+            Vertex* vertices[64];
+            Edge* edges[64];
+            loader.take(64, vertices, nv, edges, ne);
+        }
+        assert(loader.wasCanceled() && loader.takeGraph() == nullptr);
+    }
+
+    // Discarding returns at once; the worker deletes the loader when it stops
+    for (int round = 0; round < 5; ++round) {
+        GraphLoader* loader = new GraphLoader(path, &pool);
+        if (round > 0) loader->start(); // the first is never started
+        loader->discard();
+    }
+    GraphLoader::waitForDiscarded();
+
+    GraphLoader missing("no_such_file.graph");
+    missing.start();
+    while (!missing.isFinished()) {}
+    assert(missing.takeGraph() == nullptr && !missing.problems().empty());
+    std::remove(path.c_str());
+    std::remove(binaryPath.c_str());
+    std::cout << "PASÓ" << std::endl;
+}
+
+void testSegmentIndex() {
+    std::cout << "Prueba: Índice espacial de segmentos... ";
+    unsigned seed = 99;
+    auto next = [&seed]() { seed = seed * 1103515245u + 12345u; return (int)(seed >> 8); };
+    // Short edges, long ones across the whole area and points
+    auto randomSegment = [&](float* s) {
+        s[0] = (float)(next() % 20000) - 10000;
+        s[1] = (float)(next() % 20000) - 10000;
+        int kind = next() % 10;
+        float reach = kind == 0 ? 20000.0f : (kind == 1 ? 0.0f : 150.0f);
+        s[2] = s[0] + (reach ? (float)(next() % (int)(2 * reach + 1)) - reach : 0);
+        s[3] = s[1] + (reach ? (float)(next() % (int)(2 * reach + 1)) - reach : 0);
+    };
+
+    SegmentIndex index(50.0f);
+    const int n = 3000;
+    float segs[n][4];
+    bool alive[n];
+    int ids[n];
+    for (int i = 0; i < n; ++i) {
+        randomSegment(segs[i]);
+        ids[i] = index.add(segs[i][0], segs[i][1], segs[i][2], segs[i][3]);
+        alive[i] = true;
+    }
+    for (int k = 0; k < 1000; ++k) {
+        int i = next() % n;
+        if (!alive[i]) continue;
+        if (k % 3 == 0) {
+            index.remove(ids[i]);
+            alive[i] = false;
+        } else {
+            randomSegment(segs[i]);
+            index.move(ids[i], segs[i][0], segs[i][1], segs[i][2], segs[i][3]);
+        }
+    }
+    int liveCount = 0;
+    for (int i = 0; i < n; ++i) liveCount += alive[i];
+    assert(index.size() == liveCount);
+
+    int* hits = new int[index.slotCount()];
+    for (int q = 0; q < 200; ++q) {
+        // From a few units wide to much larger than everything
+        float w = (float)(q < 100 ? next() % 400 : next() % 40000);
+        float left = (float)(next() % 24000) - 12000, top = (float)(next() % 24000) - 12000;
+        for (int id = 0; id < index.slotCount(); ++id) hits[id] = 0;
+        index.query(left, top, left + w, top + w, [&](int id) { hits[id]++; });
+        for (int i = 0; i < n; ++i) {
+            const float* s = segs[i];
+            bool expected = alive[i] && std::min(s[0], s[2]) <= left + w && std::max(s[0], s[2]) >= left &&
+                            std::min(s[1], s[3]) <= top + w && std::max(s[1], s[3]) >= top;
+            assert(hits[ids[i]] == (expected ? 1 : 0));
+        }
+    }
+    delete[] hits;
+
+    // Nearest within a tolerance, against every live segment
+    for (int q = 0; q < 200; ++q) {
+        float x = (float)(next() % 20000) - 10000, y = (float)(next() % 20000) - 10000;
+        float tolerance = 40.0f;
+        double best = (double)tolerance * tolerance;
+        bool any = false;
+        for (int i = 0; i < n; ++i) {
+            if (!alive[i]) continue;
+            const float* s = segs[i];
+            double dx = (double)s[2] - s[0], dy = (double)s[3] - s[1];
+            double length = dx * dx + dy * dy;
+            double t = length > 0 ? ((x - s[0]) * dx + (y - s[1]) * dy) / length : 0;
+            t = std::max(0.0, std::min(1.0, t));
+            double px = s[0] + t * dx - x, py = s[1] + t * dy - y;
+            if (px * px + py * py <= best) {
+                best = px * px + py * py;
+                any = true;
+            }
+        }
+        int found = index.nearest(x, y, tolerance);
+        assert((found != -1) == any);
+        if (found != -1) {
+            const float* s = index.segment(found);
+            double dx = (double)s[2] - s[0], dy = (double)s[3] - s[1];
+            double length = dx * dx + dy * dy;
+            double t = length > 0 ? ((x - s[0]) * dx + (y - s[1]) * dy) / length : 0;
+            t = std::max(0.0, std::min(1.0, t));
+            double px = s[0] + t * dx - x, py = s[1] + t * dy - y;
+            assert(std::fabs(px * px + py * py - best) < 1e-6);
+        }
+    }
+
+    // Removed ids are reused, and clear() empties everything
+    int reused = index.add(0, 0, 1, 1);
+    assert(reused < n && index.isLive(reused));
+    index.clear();
+    assert(index.size() == 0 && index.nearest(0, 0, 1e6f) == -1);
+    std::cout << "PASÓ" << std::endl;
+}
+
 int main() {
     try {
         testBasicGraph();
+        testVertexIndex();
+        testCompactGraph();
         testCycles();
         testDijkstra();
+        testShortestPathTree();
+        testPathSearchModes();
+        testBlockedFloydWarshall();
+        testThreadPool();
+        testParallelAllPairs();
+        testTransitiveClosure();
+        testSpanningForest();
+        testCycleExtraction();
+        testClosenessCentrality();
+        testObjectPool();
+        testUnrolledList();
+        testIncomingIndex();
+        testBinaryFormat();
+        testTextParser();
+        testParallelTextParser();
+        testTextSave();
+        testCompressedFormat();
+        testGraphLoader();
+        testSegmentIndex();
         std::cout << "\n¡Todas las pruebas de lógica pasaron exitosamente!" << std::endl;
     } catch (const std::exception& e) {
         std::cerr << "\nFALLO EN PRUEBA: " << e.what() << std::endl;